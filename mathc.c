@@ -20,6 +20,80 @@ the following restrictions:
 
 #include "mathc.h"
 
+#if defined(MATHC_USE_FLOATING_POINT) && defined(MATHC_USE_SINGLE_FLOATING_POINT)
+#if defined(MATHC_USE_DISPATCH)
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define MATHC_SIMD_DISPATCH
+#define MATHC_SIMD_SSE2
+#define MATHC_SIMD_AVX2
+#define MATHC_SIMD_AVX512
+#endif
+#else
+#if defined(MATHC_USE_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHC_SIMD_SSE2
+#endif
+#if defined(MATHC_SIMD_SSE2) && defined(MATHC_USE_AVX2) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define MATHC_SIMD_AVX2
+#endif
+#if defined(MATHC_SIMD_AVX2) && defined(MATHC_USE_AVX512) && defined(__AVX512F__)
+#define MATHC_SIMD_AVX512
+#endif
+#endif
+#endif
+
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_BMI2) && (defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define MATHC_BMI2
+#if defined(__x86_64__) || defined(_M_X64)
+#define MATHC_BMI2_64
+#endif
+#include <immintrin.h>
+#endif
+
+#if defined(MATHC_SIMD_SSE2)
+#include <immintrin.h>
+#if defined(MATHC_SIMD_DISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(MATHC_SIMD_DISPATCH) && defined(__GNUC__)
+#define MATHC_TARGET_SSE2 __attribute__((target("sse2")))
+#define MATHC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define MATHC_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define MATHC_TARGET_SSE2
+#define MATHC_TARGET_AVX2
+#define MATHC_TARGET_AVX512
+#endif
+
+/* Implementations of the hot functions for one SIMD level */
+struct mathc_simd_kernels {
+	mfloat_t *(*fast_sin_n)(mfloat_t *result, mfloat_t *v0, size_t count);
+	mfloat_t *(*fast_cos_n)(mfloat_t *result, mfloat_t *v0, size_t count);
+	mfloat_t *(*fast_tan_n)(mfloat_t *result, mfloat_t *v0, size_t count);
+	mfloat_t *(*fast_acos_n)(mfloat_t *result, mfloat_t *v0, size_t count);
+	mfloat_t *(*fast_atan2_n)(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count);
+	mfloat_t *(*fast_pow_n)(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count);
+	mfloat_t *(*vec3_multiply_mat3_n)(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count);
+	mfloat_t *(*vec3_rotate_quat_n)(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t q0_stride, size_t count);
+	mfloat_t *(*vec4_multiply_mat4)(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+	mfloat_t *(*vec4_multiply_mat4_n)(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count);
+	mfloat_t *(*quat_multiply)(mfloat_t *result, mfloat_t *q0, mfloat_t *q1);
+	mfloat_t *(*quat_slerp_fast_n)(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t *f, size_t count);
+	mfloat_t *(*mat4_multiply)(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
+	mfloat_t *(*mat4_inverse)(mfloat_t *result, mfloat_t *m0);
+	mfloat_t *(*mat4_inverse_n)(mfloat_t *result, mfloat_t *m0, size_t count);
+	void (*mat4_skin_n)(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count);
+	void (*mat3x4_skin_n)(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count);
+	size_t (*frustum_cull_spheres_n)(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *s0, size_t count);
+	size_t (*frustum_cull_aabbs_n)(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *b0, size_t count);
+	mfloat_t *(*aabb_transform_n)(mfloat_t *result, mfloat_t *b0, mfloat_t *m0, size_t count);
+	void (*ray_intersect_triangles_n)(mfloat_t *result, mfloat_t *r0, mfloat_t *t0, size_t count);
+	void (*rays_intersect_triangle_n)(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count);
+	size_t (*ray_intersect_aabbs_n)(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count);
+};
+
+static const struct mathc_simd_kernels *mathc_simd_kernels(void);
+#endif
+
 #if defined(MATHC_USE_INT)
 mint_t clampi(mint_t value, mint_t min, mint_t max)
 {
@@ -65,6 +139,862 @@ mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max)
 }
 #endif
 
+#if defined(MATHC_USE_FLOATING_POINT) && defined(MATHC_USE_SINGLE_FLOATING_POINT)
+/* Polynomial approximations of the transcendental functions, used by MSIN,
+MCOS, MTAN, MACOS, MATAN2 and MPOW when MATHC_USE_FAST_TRIG is defined. The
+polynomials are the ones of Cephes (sinf, cosf, asinf and atanf). The SIMD
+kernels follow the same steps, with the branches turned into lane selects */
+#define FAST_TRIG_2_PI MFLOAT_C(0.636619772367581343)
+#define FAST_TRIG_PI_2_A MFLOAT_C(1.5703125)
+#define FAST_TRIG_PI_2_B MFLOAT_C(4.837512969970703125e-4)
+#define FAST_TRIG_PI_2_C MFLOAT_C(7.54953362047672271728515625e-8)
+#define FAST_TRIG_PI_2_D MFLOAT_C(2.563344068257089603e-12)
+#define FAST_TRIG_MAX MFLOAT_C(8192.0)
+#define FAST_TRIG_TAN_PI_8 MFLOAT_C(0.414213562373095049)
+#define FAST_TRIG_SQRT_2 MFLOAT_C(1.41421356237309505)
+#define FAST_TRIG_LOG2_E MFLOAT_C(1.44269504088896341)
+
+static uint32_t fast_trig_bits(mfloat_t f)
+{
+	union {
+		mfloat_t f;
+		uint32_t u;
+	} bits;
+	bits.f = f;
+	return bits.u;
+}
+
+static mfloat_t fast_trig_float(uint32_t u)
+{
+	union {
+		mfloat_t f;
+		uint32_t u;
+	} bits;
+	bits.u = u;
+	return bits.f;
+}
+
+/* `a` where `mask` is set and `b` elsewhere, without a branch */
+static mfloat_t fast_trig_select(uint32_t mask, mfloat_t a, mfloat_t b)
+{
+	return fast_trig_float((fast_trig_bits(a) & mask) | (fast_trig_bits(b) & ~mask));
+}
+
+/* Rounds to the nearest integer, halfway cases away from zero */
+static int32_t fast_trig_round(mfloat_t f)
+{
+	return (int32_t)(f + fast_trig_float(fast_trig_bits(MFLOAT_C(0.5)) | (fast_trig_bits(f) & 0x80000000)));
+}
+
+/* Reduces `f` to [-pi / 4, pi / 4] and returns the quadrant in `quadrant`.
+pi / 2 is split in four parts, the first three with 11 bits, so their
+products with the quadrant are exact up to 2^13 and the remainder keeps its
+relative accuracy next to the zeros of sin and cos. Past FAST_TRIG_MAX the
+remainder is wrong, the callers use the standard functions there */
+static mfloat_t fast_trig_reduce(mfloat_t f, int32_t *quadrant)
+{
+	mfloat_t j;
+	*quadrant = fast_trig_round(f * FAST_TRIG_2_PI);
+	j = (mfloat_t)*quadrant;
+	return (((f - j * FAST_TRIG_PI_2_A) - j * FAST_TRIG_PI_2_B) - j * FAST_TRIG_PI_2_C) - j * FAST_TRIG_PI_2_D;
+}
+
+/* The sign of `r` is copied to the result so sin(-0) is -0 */
+static mfloat_t fast_sin_polynomial(mfloat_t r, mfloat_t r2)
+{
+	mfloat_t s = r + r * r2 * (MFLOAT_C(-1.6666654611e-1) + r2 * (MFLOAT_C(8.3321608736e-3) + r2 * MFLOAT_C(-1.9515295891e-4)));
+	return fast_trig_float(fast_trig_bits(s) | (fast_trig_bits(r) & 0x80000000));
+}
+
+static mfloat_t fast_cos_polynomial(mfloat_t r2)
+{
+	return MFLOAT_C(1.0) - MFLOAT_C(0.5) * r2 + r2 * r2 * (MFLOAT_C(4.166664568298827e-2) + r2 * (MFLOAT_C(-1.388731625493765e-3) + r2 * MFLOAT_C(2.443315711809948e-5)));
+}
+
+/* sin(f + offset * pi / 2), with the polynomial and the sign picked from the
+quadrant without branches */
+static mfloat_t fast_sin_quadrant(mfloat_t f, int32_t offset)
+{
+	int32_t quadrant;
+	mfloat_t r = fast_trig_reduce(f, &quadrant);
+	mfloat_t r2 = r * r;
+	mfloat_t s = fast_sin_polynomial(r, r2);
+	mfloat_t c = fast_cos_polynomial(r2);
+	quadrant = quadrant + offset;
+	return fast_trig_float(fast_trig_bits(fast_trig_select(0u - (uint32_t)(quadrant & 1), c, s)) ^ ((uint32_t)(quadrant & 2) << 30));
+}
+
+/* Maximum error of 2.5 ULP for |f| <= 8192. Larger arguments, infinities
+and NaN are passed to sinf() */
+mfloat_t fast_sin(mfloat_t f)
+{
+	if (!(MFABS(f) <= FAST_TRIG_MAX)) {
+		return sinf(f);
+	}
+	return fast_sin_quadrant(f, 0);
+}
+
+/* Maximum error of 2.5 ULP for |f| <= 8192, cosf() past that */
+mfloat_t fast_cos(mfloat_t f)
+{
+	if (!(MFABS(f) <= FAST_TRIG_MAX)) {
+		return cosf(f);
+	}
+	return fast_sin_quadrant(f, 1);
+}
+
+/* Maximum error of 4 ULP for |f| <= 8192, tanf() past that */
+mfloat_t fast_tan(mfloat_t f)
+{
+	int32_t quadrant;
+	mfloat_t r;
+	mfloat_t r2;
+	mfloat_t s;
+	mfloat_t c;
+	uint32_t swap;
+	if (!(MFABS(f) <= FAST_TRIG_MAX)) {
+		return tanf(f);
+	}
+	r = fast_trig_reduce(f, &quadrant);
+	r2 = r * r;
+	s = fast_sin_polynomial(r, r2);
+	c = fast_cos_polynomial(r2);
+	swap = 0u - (uint32_t)(quadrant & 1);
+	return fast_trig_select(swap, -c, s) / fast_trig_select(swap, s, c);
+}
+
+static mfloat_t fast_asin_polynomial(mfloat_t f, mfloat_t f2)
+{
+	return f + f * f2 * (MFLOAT_C(1.6666752422e-1) + f2 * (MFLOAT_C(7.4953002686e-2) + f2 * (MFLOAT_C(4.5470025998e-2) + f2 * (MFLOAT_C(2.4181311049e-2) + f2 * MFLOAT_C(4.2163199048e-2)))));
+}
+
+/* Maximum error of 1.5 ULP */
+mfloat_t fast_acos(mfloat_t f)
+{
+	mfloat_t a = MFABS(f);
+	mfloat_t result;
+	if (a > MFLOAT_C(0.5)) {
+		mfloat_t z = MFLOAT_C(0.5) * (MFLOAT_C(1.0) - a);
+		result = MFLOAT_C(2.0) * fast_asin_polynomial(MSQRT(z), z);
+		if (f < MFLOAT_C(0.0)) {
+			result = MPI - result;
+		}
+	} else {
+		result = MPI_2 - fast_asin_polynomial(f, f * f);
+	}
+	return result;
+}
+
+static mfloat_t fast_atan_polynomial(mfloat_t f, mfloat_t f2)
+{
+	return f + f * f2 * (MFLOAT_C(-3.33329491539e-1) + f2 * (MFLOAT_C(1.99777106478e-1) + f2 * (MFLOAT_C(-1.38776856032e-1) + f2 * MFLOAT_C(8.05374449538e-2))));
+}
+
+/* Maximum error of 3.5 ULP */
+mfloat_t fast_atan2(mfloat_t y, mfloat_t x)
+{
+	mfloat_t ax = MFABS(x);
+	mfloat_t ay = MFABS(y);
+	mfloat_t max = ax > ay ? ax : ay;
+	mfloat_t min = ax > ay ? ay : ax;
+	mfloat_t offset = MFLOAT_C(0.0);
+	mfloat_t q;
+	mfloat_t result;
+	if (x != x || y != y) {
+		return x + y;
+	}
+	if (max == MFLOAT_C(0.0)) {
+		q = MFLOAT_C(0.0);
+	} else if (min == max) {
+		q = MFLOAT_C(1.0);
+	} else {
+		q = min / max;
+	}
+	if (q > FAST_TRIG_TAN_PI_8) {
+		q = (q - MFLOAT_C(1.0)) / (q + MFLOAT_C(1.0));
+		offset = MPI_4;
+	}
+	result = offset + fast_atan_polynomial(q, q * q);
+	if (ay > ax) {
+		result = MPI_2 - result;
+	}
+	if (signbit(x)) {
+		result = MPI - result;
+	}
+	if (signbit(y)) {
+		result = -result;
+	}
+	return result;
+}
+
+/* log2 of a positive `f`, with -INFINITY for zero and INFINITY for
+INFINITY. The mantissa is taken in [sqrt(1 / 2), sqrt(2)) and its
+logarithm is the series of atanh((m - 1) / (m + 1)) */
+static mfloat_t fast_log2(mfloat_t f)
+{
+	int32_t e = 0;
+	uint32_t bits;
+	uint32_t high;
+	mfloat_t m;
+	mfloat_t u;
+	mfloat_t u2;
+	if (f == MFLOAT_C(0.0)) {
+		return -INFINITY;
+	}
+	if (f == INFINITY) {
+		return INFINITY;
+	}
+	if (f < FLT_MIN) {
+		f = f * MFLOAT_C(8388608.0);
+		e = -23;
+	}
+	bits = fast_trig_bits(f);
+	high = (bits & 0x007fffff) > 0x003504f3;
+	e = e + (int32_t)(bits >> 23) - 127 + (int32_t)high;
+	m = fast_trig_float((bits & 0x007fffff) | (0x3f800000 - (high << 23)));
+	u = (m - MFLOAT_C(1.0)) / (m + MFLOAT_C(1.0));
+	u2 = u * u;
+	return (mfloat_t)e + MFLOAT_C(2.0) * FAST_TRIG_LOG2_E * (u + u * u2 * (MFLOAT_C(0.333333333333333333) + u2 * (MFLOAT_C(0.2) + u2 * (MFLOAT_C(0.142857142857142857) + u2 * MFLOAT_C(0.111111111111111111)))));
+}
+
+/* 2^f, infinity above 128 and zero below -150. The power of two is applied
+in two factors so results in the subnormal range are kept */
+static mfloat_t fast_exp2(mfloat_t f)
+{
+	int32_t n;
+	int32_t n0;
+	mfloat_t p;
+	f = f < MFLOAT_C(128.0) ? f : MFLOAT_C(128.0);
+	f = f > MFLOAT_C(-150.0) ? f : MFLOAT_C(-150.0);
+	n = fast_trig_round(f);
+	n0 = n / 2;
+	f = f - (mfloat_t)n;
+	p = MFLOAT_C(1.0) + f * (MFLOAT_C(0.693147180559945309) + f * (MFLOAT_C(0.240226506959100712) + f * (MFLOAT_C(0.0555041086648215800) + f * (MFLOAT_C(0.00961812910762847717) + f * (MFLOAT_C(0.00133335581464284434) + f * (MFLOAT_C(0.000154035303933816100) + f * MFLOAT_C(0.0000152527338040598403)))))));
+	return p * fast_trig_float((uint32_t)(n0 + 127) << 23) * fast_trig_float((uint32_t)(n - n0 + 127) << 23);
+}
+
+/* exp2(y * log2(|x|)), with the special cases of pow() for zeros,
+infinities, NaN and negative `x`. The error grows with the magnitude of the
+exponent of the result: below 4 + 2.5 * |y * log2(|x|)| ULP, and 1.5 ULP
+when `x` is 2, as in the exponential easing functions */
+mfloat_t fast_pow(mfloat_t x, mfloat_t y)
+{
+	mfloat_t ay = MFABS(y);
+	mfloat_t result;
+	bool integer = true;
+	bool odd = false;
+	if (x == MFLOAT_C(1.0) || y == MFLOAT_C(0.0)) {
+		return MFLOAT_C(1.0);
+	}
+	if (x != x || y != y) {
+		return x + y;
+	}
+	if (x == MFLOAT_C(-1.0) && ay == INFINITY) {
+		return MFLOAT_C(1.0);
+	}
+	result = fast_exp2(y * fast_log2(MFABS(x)));
+	if (ay < MFLOAT_C(16777216.0)) {
+		int32_t i = (int32_t)y;
+		integer = (mfloat_t)i == y;
+		odd = integer && (i & 1);
+	}
+	if (signbit(x)) {
+		if (!integer && x < MFLOAT_C(0.0) && x > -INFINITY) {
+			result = NAN;
+		} else if (odd) {
+			result = -result;
+		}
+	}
+	return result;
+}
+
+static mfloat_t *fast_sin_n_scalar(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = fast_sin(v0[i]);
+	}
+	return result;
+}
+
+static mfloat_t *fast_cos_n_scalar(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = fast_cos(v0[i]);
+	}
+	return result;
+}
+
+static mfloat_t *fast_tan_n_scalar(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = fast_tan(v0[i]);
+	}
+	return result;
+}
+
+static mfloat_t *fast_acos_n_scalar(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = fast_acos(v0[i]);
+	}
+	return result;
+}
+
+static mfloat_t *fast_atan2_n_scalar(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = fast_atan2(v0[i], v1[i]);
+	}
+	return result;
+}
+
+static mfloat_t *fast_pow_n_scalar(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = fast_pow(v0[i], v1[i]);
+	}
+	return result;
+}
+
+#if defined(MATHC_SIMD_SSE2)
+/* Computes again with `function` the lanes of a vector from `v0` whose bit
+is set in `mask`, the ones past FAST_TRIG_MAX */
+static void fast_trig_fallback(mfloat_t *result, mfloat_t *v0, int mask, mfloat_t (*function)(mfloat_t))
+{
+	for (int i = 0; mask != 0; i++, mask >>= 1) {
+		if (mask & 1) {
+			result[i] = function(v0[i]);
+		}
+	}
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_select_sse2(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_round_sse2(__m128 f)
+{
+	return _mm_add_ps(f, _mm_or_ps(_mm_and_ps(f, _mm_set1_ps(MFLOAT_C(-0.0))), _mm_set1_ps(MFLOAT_C(0.5))));
+}
+
+/* Returns the mask of the lanes past FAST_TRIG_MAX or NaN, whose results
+are wrong */
+static MATHC_TARGET_SSE2 int fast_sincos_sse2(__m128 f, __m128 *sine, __m128 *cosine)
+{
+	__m128 sign_bit = _mm_set1_ps(MFLOAT_C(-0.0));
+	__m128i one = _mm_set1_epi32(1);
+	__m128 t = _mm_mul_ps(f, _mm_set1_ps(FAST_TRIG_2_PI));
+	__m128i quadrant;
+	__m128 j;
+	__m128 r;
+	__m128 r2;
+	__m128 s;
+	__m128 c;
+	__m128 swap;
+	__m128 negate;
+	quadrant = _mm_cvttps_epi32(fast_round_sse2(t));
+	j = _mm_cvtepi32_ps(quadrant);
+	r = _mm_sub_ps(f, _mm_mul_ps(j, _mm_set1_ps(FAST_TRIG_PI_2_A)));
+	r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(FAST_TRIG_PI_2_B)));
+	r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(FAST_TRIG_PI_2_C)));
+	r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(FAST_TRIG_PI_2_D)));
+	r2 = _mm_mul_ps(r, r);
+	s = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(MFLOAT_C(-1.9515295891e-4))), _mm_set1_ps(MFLOAT_C(8.3321608736e-3)));
+	s = _mm_add_ps(_mm_mul_ps(r2, s), _mm_set1_ps(MFLOAT_C(-1.6666654611e-1)));
+	s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+	s = _mm_or_ps(s, _mm_and_ps(r, sign_bit));
+	c = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(MFLOAT_C(2.443315711809948e-5))), _mm_set1_ps(MFLOAT_C(-1.388731625493765e-3)));
+	c = _mm_add_ps(_mm_mul_ps(r2, c), _mm_set1_ps(MFLOAT_C(4.166664568298827e-2)));
+	c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(MFLOAT_C(1.0)), _mm_mul_ps(_mm_set1_ps(MFLOAT_C(0.5)), r2)), _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+	swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+	negate = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+	*sine = _mm_xor_ps(fast_select_sse2(swap, c, s), negate);
+	*cosine = _mm_xor_ps(fast_select_sse2(swap, _mm_xor_ps(s, sign_bit), c), negate);
+	return _mm_movemask_ps(_mm_cmpnle_ps(_mm_andnot_ps(sign_bit, f), _mm_set1_ps(FAST_TRIG_MAX)));
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_acos_sse2(__m128 f)
+{
+	__m128 half = _mm_set1_ps(MFLOAT_C(0.5));
+	__m128 a = _mm_andnot_ps(_mm_set1_ps(MFLOAT_C(-0.0)), f);
+	__m128 large = _mm_cmpgt_ps(a, half);
+	__m128 z = _mm_mul_ps(half, _mm_sub_ps(_mm_set1_ps(MFLOAT_C(1.0)), a));
+	__m128 x = fast_select_sse2(large, _mm_sqrt_ps(z), f);
+	__m128 p;
+	z = fast_select_sse2(large, z, _mm_mul_ps(f, f));
+	p = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(MFLOAT_C(4.2163199048e-2))), _mm_set1_ps(MFLOAT_C(2.4181311049e-2)));
+	p = _mm_add_ps(_mm_mul_ps(z, p), _mm_set1_ps(MFLOAT_C(4.5470025998e-2)));
+	p = _mm_add_ps(_mm_mul_ps(z, p), _mm_set1_ps(MFLOAT_C(7.4953002686e-2)));
+	p = _mm_add_ps(_mm_mul_ps(z, p), _mm_set1_ps(MFLOAT_C(1.6666752422e-1)));
+	p = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, z), p));
+	a = _mm_add_ps(p, p);
+	a = fast_select_sse2(_mm_cmplt_ps(f, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(MPI), a), a);
+	return fast_select_sse2(large, a, _mm_sub_ps(_mm_set1_ps(MPI_2), p));
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_atan2_sse2(__m128 y, __m128 x)
+{
+	__m128 sign_bit = _mm_set1_ps(MFLOAT_C(-0.0));
+	__m128 one = _mm_set1_ps(MFLOAT_C(1.0));
+	__m128 ax = _mm_andnot_ps(sign_bit, x);
+	__m128 ay = _mm_andnot_ps(sign_bit, y);
+	__m128 max = _mm_max_ps(ax, ay);
+	__m128 min = _mm_min_ps(ax, ay);
+	__m128 q = _mm_div_ps(min, max);
+	__m128 reduce;
+	__m128 q2;
+	__m128 result;
+	q = fast_select_sse2(_mm_cmpeq_ps(min, max), one, q);
+	q = _mm_andnot_ps(_mm_cmpeq_ps(max, _mm_setzero_ps()), q);
+	reduce = _mm_cmpgt_ps(q, _mm_set1_ps(FAST_TRIG_TAN_PI_8));
+	q = fast_select_sse2(reduce, _mm_div_ps(_mm_sub_ps(q, one), _mm_add_ps(q, one)), q);
+	q2 = _mm_mul_ps(q, q);
+	result = _mm_add_ps(_mm_mul_ps(q2, _mm_set1_ps(MFLOAT_C(8.05374449538e-2))), _mm_set1_ps(MFLOAT_C(-1.38776856032e-1)));
+	result = _mm_add_ps(_mm_mul_ps(q2, result), _mm_set1_ps(MFLOAT_C(1.99777106478e-1)));
+	result = _mm_add_ps(_mm_mul_ps(q2, result), _mm_set1_ps(MFLOAT_C(-3.33329491539e-1)));
+	result = _mm_add_ps(q, _mm_mul_ps(_mm_mul_ps(q, q2), result));
+	result = _mm_add_ps(_mm_and_ps(reduce, _mm_set1_ps(MPI_4)), result);
+	result = fast_select_sse2(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(MPI_2), result), result);
+	result = fast_select_sse2(_mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31)), _mm_sub_ps(_mm_set1_ps(MPI), result), result);
+	result = _mm_xor_ps(result, _mm_and_ps(y, sign_bit));
+	return fast_select_sse2(_mm_cmpunord_ps(x, y), _mm_add_ps(x, y), result);
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_log2_sse2(__m128 f)
+{
+	__m128 one = _mm_set1_ps(MFLOAT_C(1.0));
+	__m128 subnormal = _mm_cmplt_ps(f, _mm_set1_ps(FLT_MIN));
+	__m128 x = fast_select_sse2(subnormal, _mm_mul_ps(f, _mm_set1_ps(MFLOAT_C(8388608.0))), f);
+	__m128i bits = _mm_castps_si128(x);
+	__m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+	__m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+	__m128 high = _mm_cmpgt_ps(m, _mm_set1_ps(FAST_TRIG_SQRT_2));
+	__m128 u;
+	__m128 u2;
+	__m128 p;
+	e = _mm_add_epi32(e, _mm_and_si128(_mm_castps_si128(subnormal), _mm_set1_epi32(-23)));
+	e = _mm_sub_epi32(e, _mm_castps_si128(high));
+	m = fast_select_sse2(high, _mm_mul_ps(m, _mm_set1_ps(MFLOAT_C(0.5))), m);
+	u = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+	u2 = _mm_mul_ps(u, u);
+	p = _mm_add_ps(_mm_mul_ps(u2, _mm_set1_ps(MFLOAT_C(0.111111111111111111))), _mm_set1_ps(MFLOAT_C(0.142857142857142857)));
+	p = _mm_add_ps(_mm_mul_ps(u2, p), _mm_set1_ps(MFLOAT_C(0.2)));
+	p = _mm_add_ps(_mm_mul_ps(u2, p), _mm_set1_ps(MFLOAT_C(0.333333333333333333)));
+	p = _mm_add_ps(u, _mm_mul_ps(_mm_mul_ps(u, u2), p));
+	p = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(_mm_set1_ps(MFLOAT_C(2.0) * FAST_TRIG_LOG2_E), p));
+	p = fast_select_sse2(_mm_cmpeq_ps(f, _mm_setzero_ps()), _mm_set1_ps(-INFINITY), p);
+	return fast_select_sse2(_mm_cmpeq_ps(f, _mm_set1_ps(INFINITY)), f, p);
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_exp2_sse2(__m128 f)
+{
+	__m128i bias = _mm_set1_epi32(127);
+	__m128i n;
+	__m128i n0;
+	__m128 p;
+	f = _mm_max_ps(_mm_min_ps(f, _mm_set1_ps(MFLOAT_C(128.0))), _mm_set1_ps(MFLOAT_C(-150.0)));
+	n = _mm_cvttps_epi32(fast_round_sse2(f));
+	n0 = _mm_srai_epi32(_mm_add_epi32(n, _mm_srli_epi32(n, 31)), 1);
+	f = _mm_sub_ps(f, _mm_cvtepi32_ps(n));
+	p = _mm_add_ps(_mm_mul_ps(f, _mm_set1_ps(MFLOAT_C(0.0000152527338040598403))), _mm_set1_ps(MFLOAT_C(0.000154035303933816100)));
+	p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(MFLOAT_C(0.00133335581464284434)));
+	p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(MFLOAT_C(0.00961812910762847717)));
+	p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(MFLOAT_C(0.0555041086648215800)));
+	p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(MFLOAT_C(0.240226506959100712)));
+	p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(MFLOAT_C(0.693147180559945309)));
+	p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(MFLOAT_C(1.0)));
+	p = _mm_mul_ps(p, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n0, bias), 23)));
+	return _mm_mul_ps(p, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(n, n0), bias), 23)));
+}
+
+static MATHC_TARGET_SSE2 __m128 fast_pow_sse2(__m128 x, __m128 y)
+{
+	__m128 sign_bit = _mm_set1_ps(MFLOAT_C(-0.0));
+	__m128 one = _mm_set1_ps(MFLOAT_C(1.0));
+	__m128 infinity = _mm_set1_ps(INFINITY);
+	__m128 ay = _mm_andnot_ps(sign_bit, y);
+	__m128 result = fast_exp2_sse2(_mm_mul_ps(y, fast_log2_sse2(_mm_andnot_ps(sign_bit, x))));
+	__m128 small = _mm_cmplt_ps(ay, _mm_set1_ps(MFLOAT_C(16777216.0)));
+	__m128i i = _mm_cvttps_epi32(y);
+	__m128 integer = _mm_or_ps(_mm_cmpeq_ps(_mm_cvtepi32_ps(i), y), _mm_cmpge_ps(ay, _mm_set1_ps(MFLOAT_C(16777216.0))));
+	__m128 odd = _mm_and_ps(_mm_and_ps(small, integer), _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(i, _mm_set1_epi32(1)), _mm_set1_epi32(1))));
+	__m128 negative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+	__m128 invalid = _mm_andnot_ps(integer, _mm_and_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_cmpgt_ps(x, _mm_set1_ps(-INFINITY))));
+	result = _mm_xor_ps(result, _mm_and_ps(_mm_and_ps(negative, odd), sign_bit));
+	result = fast_select_sse2(invalid, _mm_set1_ps(NAN), result);
+	result = fast_select_sse2(_mm_and_ps(_mm_cmpeq_ps(x, _mm_set1_ps(MFLOAT_C(-1.0))), _mm_cmpeq_ps(ay, infinity)), one, result);
+	result = fast_select_sse2(_mm_cmpunord_ps(x, y), _mm_add_ps(x, y), result);
+	return fast_select_sse2(_mm_or_ps(_mm_cmpeq_ps(x, one), _mm_cmpeq_ps(y, _mm_setzero_ps())), one, result);
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *fast_sin_n_sse2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	__m128 s;
+	__m128 c;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		int mask = fast_sincos_sse2(_mm_loadu_ps(v0 + i), &s, &c);
+		_mm_storeu_ps(result + i, s);
+		if (mask != 0) {
+			fast_trig_fallback(result + i, v0 + i, mask, sinf);
+		}
+	}
+	fast_sin_n_scalar(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *fast_cos_n_sse2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	__m128 s;
+	__m128 c;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		int mask = fast_sincos_sse2(_mm_loadu_ps(v0 + i), &s, &c);
+		_mm_storeu_ps(result + i, c);
+		if (mask != 0) {
+			fast_trig_fallback(result + i, v0 + i, mask, cosf);
+		}
+	}
+	fast_cos_n_scalar(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *fast_tan_n_sse2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	__m128 s;
+	__m128 c;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		int mask = fast_sincos_sse2(_mm_loadu_ps(v0 + i), &s, &c);
+		_mm_storeu_ps(result + i, _mm_div_ps(s, c));
+		if (mask != 0) {
+			fast_trig_fallback(result + i, v0 + i, mask, tanf);
+		}
+	}
+	fast_tan_n_scalar(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *fast_acos_n_sse2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(result + i, fast_acos_sse2(_mm_loadu_ps(v0 + i)));
+	}
+	fast_acos_n_scalar(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *fast_atan2_n_sse2(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(result + i, fast_atan2_sse2(_mm_loadu_ps(v0 + i), _mm_loadu_ps(v1 + i)));
+	}
+	fast_atan2_n_scalar(result + i, v0 + i, v1 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *fast_pow_n_sse2(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(result + i, fast_pow_sse2(_mm_loadu_ps(v0 + i), _mm_loadu_ps(v1 + i)));
+	}
+	fast_pow_n_scalar(result + i, v0 + i, v1 + i, count - i);
+	return result;
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 __m256 fast_round_avx2(__m256 f)
+{
+	return _mm256_add_ps(f, _mm256_or_ps(_mm256_and_ps(f, _mm256_set1_ps(MFLOAT_C(-0.0))), _mm256_set1_ps(MFLOAT_C(0.5))));
+}
+
+/* Returns the mask of the lanes past FAST_TRIG_MAX or NaN */
+static MATHC_TARGET_AVX2 int fast_sincos_avx2(__m256 f, __m256 *sine, __m256 *cosine)
+{
+	__m256 sign_bit = _mm256_set1_ps(MFLOAT_C(-0.0));
+	__m256i one = _mm256_set1_epi32(1);
+	__m256 t = _mm256_mul_ps(f, _mm256_set1_ps(FAST_TRIG_2_PI));
+	__m256i quadrant;
+	__m256 j;
+	__m256 r;
+	__m256 r2;
+	__m256 s;
+	__m256 c;
+	__m256 swap;
+	__m256 negate;
+	quadrant = _mm256_cvttps_epi32(fast_round_avx2(t));
+	j = _mm256_cvtepi32_ps(quadrant);
+	r = _mm256_fnmadd_ps(j, _mm256_set1_ps(FAST_TRIG_PI_2_A), f);
+	r = _mm256_fnmadd_ps(j, _mm256_set1_ps(FAST_TRIG_PI_2_B), r);
+	r = _mm256_fnmadd_ps(j, _mm256_set1_ps(FAST_TRIG_PI_2_C), r);
+	r = _mm256_fnmadd_ps(j, _mm256_set1_ps(FAST_TRIG_PI_2_D), r);
+	r2 = _mm256_mul_ps(r, r);
+	s = _mm256_fmadd_ps(r2, _mm256_set1_ps(MFLOAT_C(-1.9515295891e-4)), _mm256_set1_ps(MFLOAT_C(8.3321608736e-3)));
+	s = _mm256_fmadd_ps(r2, s, _mm256_set1_ps(MFLOAT_C(-1.6666654611e-1)));
+	s = _mm256_fmadd_ps(_mm256_mul_ps(r, r2), s, r);
+	s = _mm256_or_ps(s, _mm256_and_ps(r, sign_bit));
+	c = _mm256_fmadd_ps(r2, _mm256_set1_ps(MFLOAT_C(2.443315711809948e-5)), _mm256_set1_ps(MFLOAT_C(-1.388731625493765e-3)));
+	c = _mm256_fmadd_ps(r2, c, _mm256_set1_ps(MFLOAT_C(4.166664568298827e-2)));
+	c = _mm256_fmadd_ps(_mm256_mul_ps(r2, r2), c, _mm256_fnmadd_ps(_mm256_set1_ps(MFLOAT_C(0.5)), r2, _mm256_set1_ps(MFLOAT_C(1.0))));
+	swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+	negate = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+	*sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), negate);
+	*cosine = _mm256_xor_ps(_mm256_blendv_ps(c, _mm256_xor_ps(s, sign_bit), swap), negate);
+	return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign_bit, f), _mm256_set1_ps(FAST_TRIG_MAX), _CMP_NLE_UQ));
+}
+
+static MATHC_TARGET_AVX2 __m256 fast_acos_avx2(__m256 f)
+{
+	__m256 half = _mm256_set1_ps(MFLOAT_C(0.5));
+	__m256 a = _mm256_andnot_ps(_mm256_set1_ps(MFLOAT_C(-0.0)), f);
+	__m256 large = _mm256_cmp_ps(a, half, _CMP_GT_OQ);
+	__m256 z = _mm256_fnmadd_ps(half, a, half);
+	__m256 x = _mm256_blendv_ps(f, _mm256_sqrt_ps(z), large);
+	__m256 p;
+	z = _mm256_blendv_ps(_mm256_mul_ps(f, f), z, large);
+	p = _mm256_fmadd_ps(z, _mm256_set1_ps(MFLOAT_C(4.2163199048e-2)), _mm256_set1_ps(MFLOAT_C(2.4181311049e-2)));
+	p = _mm256_fmadd_ps(z, p, _mm256_set1_ps(MFLOAT_C(4.5470025998e-2)));
+	p = _mm256_fmadd_ps(z, p, _mm256_set1_ps(MFLOAT_C(7.4953002686e-2)));
+	p = _mm256_fmadd_ps(z, p, _mm256_set1_ps(MFLOAT_C(1.6666752422e-1)));
+	p = _mm256_fmadd_ps(_mm256_mul_ps(x, z), p, x);
+	a = _mm256_add_ps(p, p);
+	a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(MPI), a), _mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_LT_OQ));
+	return _mm256_blendv_ps(_mm256_sub_ps(_mm256_set1_ps(MPI_2), p), a, large);
+}
+
+static MATHC_TARGET_AVX2 __m256 fast_atan2_avx2(__m256 y, __m256 x)
+{
+	__m256 sign_bit = _mm256_set1_ps(MFLOAT_C(-0.0));
+	__m256 one = _mm256_set1_ps(MFLOAT_C(1.0));
+	__m256 ax = _mm256_andnot_ps(sign_bit, x);
+	__m256 ay = _mm256_andnot_ps(sign_bit, y);
+	__m256 max = _mm256_max_ps(ax, ay);
+	__m256 min = _mm256_min_ps(ax, ay);
+	__m256 q = _mm256_div_ps(min, max);
+	__m256 reduce;
+	__m256 q2;
+	__m256 result;
+	q = _mm256_blendv_ps(q, one, _mm256_cmp_ps(min, max, _CMP_EQ_OQ));
+	q = _mm256_andnot_ps(_mm256_cmp_ps(max, _mm256_setzero_ps(), _CMP_EQ_OQ), q);
+	reduce = _mm256_cmp_ps(q, _mm256_set1_ps(FAST_TRIG_TAN_PI_8), _CMP_GT_OQ);
+	q = _mm256_blendv_ps(q, _mm256_div_ps(_mm256_sub_ps(q, one), _mm256_add_ps(q, one)), reduce);
+	q2 = _mm256_mul_ps(q, q);
+	result = _mm256_fmadd_ps(q2, _mm256_set1_ps(MFLOAT_C(8.05374449538e-2)), _mm256_set1_ps(MFLOAT_C(-1.38776856032e-1)));
+	result = _mm256_fmadd_ps(q2, result, _mm256_set1_ps(MFLOAT_C(1.99777106478e-1)));
+	result = _mm256_fmadd_ps(q2, result, _mm256_set1_ps(MFLOAT_C(-3.33329491539e-1)));
+	result = _mm256_fmadd_ps(_mm256_mul_ps(q, q2), result, q);
+	result = _mm256_add_ps(_mm256_and_ps(reduce, _mm256_set1_ps(MPI_4)), result);
+	result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(MPI_2), result), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+	result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(MPI), result), x);
+	result = _mm256_xor_ps(result, _mm256_and_ps(y, sign_bit));
+	return _mm256_blendv_ps(result, _mm256_add_ps(x, y), _mm256_cmp_ps(x, y, _CMP_UNORD_Q));
+}
+
+static MATHC_TARGET_AVX2 __m256 fast_log2_avx2(__m256 f)
+{
+	__m256 one = _mm256_set1_ps(MFLOAT_C(1.0));
+	__m256 subnormal = _mm256_cmp_ps(f, _mm256_set1_ps(FLT_MIN), _CMP_LT_OQ);
+	__m256 x = _mm256_blendv_ps(f, _mm256_mul_ps(f, _mm256_set1_ps(MFLOAT_C(8388608.0))), subnormal);
+	__m256i bits = _mm256_castps_si256(x);
+	__m256i e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+	__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+	__m256 high = _mm256_cmp_ps(m, _mm256_set1_ps(FAST_TRIG_SQRT_2), _CMP_GT_OQ);
+	__m256 u;
+	__m256 u2;
+	__m256 p;
+	e = _mm256_add_epi32(e, _mm256_and_si256(_mm256_castps_si256(subnormal), _mm256_set1_epi32(-23)));
+	e = _mm256_sub_epi32(e, _mm256_castps_si256(high));
+	m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(MFLOAT_C(0.5))), high);
+	u = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+	u2 = _mm256_mul_ps(u, u);
+	p = _mm256_fmadd_ps(u2, _mm256_set1_ps(MFLOAT_C(0.111111111111111111)), _mm256_set1_ps(MFLOAT_C(0.142857142857142857)));
+	p = _mm256_fmadd_ps(u2, p, _mm256_set1_ps(MFLOAT_C(0.2)));
+	p = _mm256_fmadd_ps(u2, p, _mm256_set1_ps(MFLOAT_C(0.333333333333333333)));
+	p = _mm256_fmadd_ps(_mm256_mul_ps(u, u2), p, u);
+	p = _mm256_fmadd_ps(_mm256_set1_ps(MFLOAT_C(2.0) * FAST_TRIG_LOG2_E), p, _mm256_cvtepi32_ps(e));
+	p = _mm256_blendv_ps(p, _mm256_set1_ps(-INFINITY), _mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_EQ_OQ));
+	return _mm256_blendv_ps(p, f, _mm256_cmp_ps(f, _mm256_set1_ps(INFINITY), _CMP_EQ_OQ));
+}
+
+static MATHC_TARGET_AVX2 __m256 fast_exp2_avx2(__m256 f)
+{
+	__m256i bias = _mm256_set1_epi32(127);
+	__m256i n;
+	__m256i n0;
+	__m256 p;
+	f = _mm256_max_ps(_mm256_min_ps(f, _mm256_set1_ps(MFLOAT_C(128.0))), _mm256_set1_ps(MFLOAT_C(-150.0)));
+	n = _mm256_cvttps_epi32(fast_round_avx2(f));
+	n0 = _mm256_srai_epi32(_mm256_add_epi32(n, _mm256_srli_epi32(n, 31)), 1);
+	f = _mm256_sub_ps(f, _mm256_cvtepi32_ps(n));
+	p = _mm256_fmadd_ps(f, _mm256_set1_ps(MFLOAT_C(0.0000152527338040598403)), _mm256_set1_ps(MFLOAT_C(0.000154035303933816100)));
+	p = _mm256_fmadd_ps(f, p, _mm256_set1_ps(MFLOAT_C(0.00133335581464284434)));
+	p = _mm256_fmadd_ps(f, p, _mm256_set1_ps(MFLOAT_C(0.00961812910762847717)));
+	p = _mm256_fmadd_ps(f, p, _mm256_set1_ps(MFLOAT_C(0.0555041086648215800)));
+	p = _mm256_fmadd_ps(f, p, _mm256_set1_ps(MFLOAT_C(0.240226506959100712)));
+	p = _mm256_fmadd_ps(f, p, _mm256_set1_ps(MFLOAT_C(0.693147180559945309)));
+	p = _mm256_fmadd_ps(f, p, _mm256_set1_ps(MFLOAT_C(1.0)));
+	p = _mm256_mul_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n0, bias), 23)));
+	return _mm256_mul_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(n, n0), bias), 23)));
+}
+
+static MATHC_TARGET_AVX2 __m256 fast_pow_avx2(__m256 x, __m256 y)
+{
+	__m256 sign_bit = _mm256_set1_ps(MFLOAT_C(-0.0));
+	__m256 one = _mm256_set1_ps(MFLOAT_C(1.0));
+	__m256 limit = _mm256_set1_ps(MFLOAT_C(16777216.0));
+	__m256 ay = _mm256_andnot_ps(sign_bit, y);
+	__m256 result = fast_exp2_avx2(_mm256_mul_ps(y, fast_log2_avx2(_mm256_andnot_ps(sign_bit, x))));
+	__m256 small = _mm256_cmp_ps(ay, limit, _CMP_LT_OQ);
+	__m256i i = _mm256_cvttps_epi32(y);
+	__m256 integer = _mm256_or_ps(_mm256_cmp_ps(_mm256_cvtepi32_ps(i), y, _CMP_EQ_OQ), _mm256_cmp_ps(ay, limit, _CMP_GE_OQ));
+	__m256 odd = _mm256_and_ps(_mm256_and_ps(small, integer), _mm256_castsi256_ps(_mm256_slli_epi32(i, 31)));
+	__m256 invalid = _mm256_andnot_ps(integer, _mm256_and_ps(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_cmp_ps(x, _mm256_set1_ps(-INFINITY), _CMP_GT_OQ)));
+	result = _mm256_xor_ps(result, _mm256_and_ps(_mm256_and_ps(x, odd), sign_bit));
+	result = _mm256_blendv_ps(result, _mm256_set1_ps(NAN), invalid);
+	result = _mm256_blendv_ps(result, one, _mm256_and_ps(_mm256_cmp_ps(x, _mm256_set1_ps(MFLOAT_C(-1.0)), _CMP_EQ_OQ), _mm256_cmp_ps(ay, _mm256_set1_ps(INFINITY), _CMP_EQ_OQ)));
+	result = _mm256_blendv_ps(result, _mm256_add_ps(x, y), _mm256_cmp_ps(x, y, _CMP_UNORD_Q));
+	return _mm256_blendv_ps(result, one, _mm256_or_ps(_mm256_cmp_ps(x, one, _CMP_EQ_OQ), _mm256_cmp_ps(y, _mm256_setzero_ps(), _CMP_EQ_OQ)));
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *fast_sin_n_avx2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	__m256 s;
+	__m256 c;
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		int mask = fast_sincos_avx2(_mm256_loadu_ps(v0 + i), &s, &c);
+		_mm256_storeu_ps(result + i, s);
+		if (mask != 0) {
+			fast_trig_fallback(result + i, v0 + i, mask, sinf);
+		}
+	}
+	fast_sin_n_sse2(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *fast_cos_n_avx2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	__m256 s;
+	__m256 c;
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		int mask = fast_sincos_avx2(_mm256_loadu_ps(v0 + i), &s, &c);
+		_mm256_storeu_ps(result + i, c);
+		if (mask != 0) {
+			fast_trig_fallback(result + i, v0 + i, mask, cosf);
+		}
+	}
+	fast_cos_n_sse2(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *fast_tan_n_avx2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	__m256 s;
+	__m256 c;
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		int mask = fast_sincos_avx2(_mm256_loadu_ps(v0 + i), &s, &c);
+		_mm256_storeu_ps(result + i, _mm256_div_ps(s, c));
+		if (mask != 0) {
+			fast_trig_fallback(result + i, v0 + i, mask, tanf);
+		}
+	}
+	fast_tan_n_sse2(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *fast_acos_n_avx2(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(result + i, fast_acos_avx2(_mm256_loadu_ps(v0 + i)));
+	}
+	fast_acos_n_sse2(result + i, v0 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *fast_atan2_n_avx2(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(result + i, fast_atan2_avx2(_mm256_loadu_ps(v0 + i), _mm256_loadu_ps(v1 + i)));
+	}
+	fast_atan2_n_sse2(result + i, v0 + i, v1 + i, count - i);
+	return result;
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *fast_pow_n_avx2(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(result + i, fast_pow_avx2(_mm256_loadu_ps(v0 + i), _mm256_loadu_ps(v1 + i)));
+	}
+	fast_pow_n_sse2(result + i, v0 + i, v1 + i, count - i);
+	return result;
+}
+#endif
+
+mfloat_t *fast_sin_n(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->fast_sin_n(result, v0, count);
+#else
+	return fast_sin_n_scalar(result, v0, count);
+#endif
+}
+
+mfloat_t *fast_cos_n(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->fast_cos_n(result, v0, count);
+#else
+	return fast_cos_n_scalar(result, v0, count);
+#endif
+}
+
+mfloat_t *fast_tan_n(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->fast_tan_n(result, v0, count);
+#else
+	return fast_tan_n_scalar(result, v0, count);
+#endif
+}
+
+mfloat_t *fast_acos_n(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->fast_acos_n(result, v0, count);
+#else
+	return fast_acos_n_scalar(result, v0, count);
+#endif
+}
+
+mfloat_t *fast_atan2_n(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->fast_atan2_n(result, v0, v1, count);
+#else
+	return fast_atan2_n_scalar(result, v0, v1, count);
+#endif
+}
+
+mfloat_t *fast_pow_n(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->fast_pow_n(result, v0, v1, count);
+#else
+	return fast_pow_n_scalar(result, v0, v1, count);
+#endif
+}
+#endif
+
 #if defined(MATHC_USE_INT)
 bool vec2i_is_zero(mint_t *v0)
 {
@@ -776,59 +1706,404 @@ mint_t *vec4i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
 	vec4i_max(result, v0, v2);
 	return result;
 }
+
+/* Morton codes interleave the bits of the coordinates, x in the lowest
+bit. The coordinates are taken as unsigned and truncated to 16 bits for
+vec2i and 32-bit codes, 32 bits for vec2i and 64-bit codes, 10 bits for
+vec3i and 32-bit codes and 21 bits for vec3i and 64-bit codes. Without
+BMI2, the bits are spread and gathered with the magic numbers of the
+shifts by 8, 4, 2 and 1 (and by 16 or 32 for the wider ones) */
+static uint32_t morton_part_1by1(uint32_t x)
+{
+#if defined(MATHC_BMI2)
+	return _pdep_u32(x, UINT32_C(0x55555555));
+#else
+	x = x & UINT32_C(0x0000ffff);
+	x = (x | (x << 8)) & UINT32_C(0x00ff00ff);
+	x = (x | (x << 4)) & UINT32_C(0x0f0f0f0f);
+	x = (x | (x << 2)) & UINT32_C(0x33333333);
+	x = (x | (x << 1)) & UINT32_C(0x55555555);
+	return x;
 #endif
+}
 
-#if defined(MATHC_USE_FLOATING_POINT)
-bool vec2_is_zero(mfloat_t *v0)
+static uint32_t morton_compact_1by1(uint32_t x)
 {
-	return MFABS(v0[0]) < MFLT_EPSILON && MFABS(v0[1]) < MFLT_EPSILON;
+#if defined(MATHC_BMI2)
+	return _pext_u32(x, UINT32_C(0x55555555));
+#else
+	x = x & UINT32_C(0x55555555);
+	x = (x | (x >> 1)) & UINT32_C(0x33333333);
+	x = (x | (x >> 2)) & UINT32_C(0x0f0f0f0f);
+	x = (x | (x >> 4)) & UINT32_C(0x00ff00ff);
+	x = (x | (x >> 8)) & UINT32_C(0x0000ffff);
+	return x;
+#endif
 }
 
-bool vec2_is_equal(mfloat_t *v0, mfloat_t *v1)
+static uint32_t morton_part_1by2(uint32_t x)
 {
-	return MFABS(v0[0] - v1[0]) < MFLT_EPSILON && MFABS(v0[1] - v1[1]) < MFLT_EPSILON;
+#if defined(MATHC_BMI2)
+	return _pdep_u32(x, UINT32_C(0x09249249));
+#else
+	x = x & UINT32_C(0x000003ff);
+	x = (x | (x << 16)) & UINT32_C(0x030000ff);
+	x = (x | (x << 8)) & UINT32_C(0x0300f00f);
+	x = (x | (x << 4)) & UINT32_C(0x030c30c3);
+	x = (x | (x << 2)) & UINT32_C(0x09249249);
+	return x;
+#endif
 }
 
-mfloat_t *vec2(mfloat_t *result, mfloat_t x, mfloat_t y)
+static uint32_t morton_compact_1by2(uint32_t x)
 {
-	result[0] = x;
-	result[1] = y;
-	return result;
+#if defined(MATHC_BMI2)
+	return _pext_u32(x, UINT32_C(0x09249249));
+#else
+	x = x & UINT32_C(0x09249249);
+	x = (x | (x >> 2)) & UINT32_C(0x030c30c3);
+	x = (x | (x >> 4)) & UINT32_C(0x0300f00f);
+	x = (x | (x >> 8)) & UINT32_C(0x030000ff);
+	x = (x | (x >> 16)) & UINT32_C(0x000003ff);
+	return x;
+#endif
 }
 
-mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0)
+static uint64_t morton64_part_1by1(uint64_t x)
 {
-	result[0] = v0[0];
-	result[1] = v0[1];
-	return result;
+#if defined(MATHC_BMI2_64)
+	return _pdep_u64(x, UINT64_C(0x5555555555555555));
+#else
+	x = x & UINT64_C(0x00000000ffffffff);
+	x = (x | (x << 16)) & UINT64_C(0x0000ffff0000ffff);
+	x = (x | (x << 8)) & UINT64_C(0x00ff00ff00ff00ff);
+	x = (x | (x << 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+	x = (x | (x << 2)) & UINT64_C(0x3333333333333333);
+	x = (x | (x << 1)) & UINT64_C(0x5555555555555555);
+	return x;
+#endif
 }
 
-#if defined(MATHC_USE_INT)
-mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0)
+static uint64_t morton64_compact_1by1(uint64_t x)
 {
-	result[0] = v0[0];
-	result[1] = v0[1];
-	return result;
+#if defined(MATHC_BMI2_64)
+	return _pext_u64(x, UINT64_C(0x5555555555555555));
+#else
+	x = x & UINT64_C(0x5555555555555555);
+	x = (x | (x >> 1)) & UINT64_C(0x3333333333333333);
+	x = (x | (x >> 2)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+	x = (x | (x >> 4)) & UINT64_C(0x00ff00ff00ff00ff);
+	x = (x | (x >> 8)) & UINT64_C(0x0000ffff0000ffff);
+	x = (x | (x >> 16)) & UINT64_C(0x00000000ffffffff);
+	return x;
+#endif
 }
+
+static uint64_t morton64_part_1by2(uint64_t x)
+{
+#if defined(MATHC_BMI2_64)
+	return _pdep_u64(x, UINT64_C(0x1249249249249249));
+#else
+	x = x & UINT64_C(0x00000000001fffff);
+	x = (x | (x << 32)) & UINT64_C(0x001f00000000ffff);
+	x = (x | (x << 16)) & UINT64_C(0x001f0000ff0000ff);
+	x = (x | (x << 8)) & UINT64_C(0x100f00f00f00f00f);
+	x = (x | (x << 4)) & UINT64_C(0x10c30c30c30c30c3);
+	x = (x | (x << 2)) & UINT64_C(0x1249249249249249);
+	return x;
 #endif
+}
 
-mfloat_t *vec2_zero(mfloat_t *result)
+static uint64_t morton64_compact_1by2(uint64_t x)
 {
-	result[0] = MFLOAT_C(0.0);
-	result[1] = MFLOAT_C(0.0);
-	return result;
+#if defined(MATHC_BMI2_64)
+	return _pext_u64(x, UINT64_C(0x1249249249249249));
+#else
+	x = x & UINT64_C(0x1249249249249249);
+	x = (x | (x >> 2)) & UINT64_C(0x10c30c30c30c30c3);
+	x = (x | (x >> 4)) & UINT64_C(0x100f00f00f00f00f);
+	x = (x | (x >> 8)) & UINT64_C(0x001f0000ff0000ff);
+	x = (x | (x >> 16)) & UINT64_C(0x001f00000000ffff);
+	x = (x | (x >> 32)) & UINT64_C(0x00000000001fffff);
+	return x;
+#endif
 }
 
-mfloat_t *vec2_one(mfloat_t *result)
+uint32_t vec2i_to_morton(mint_t *v0)
 {
-	result[0] = MFLOAT_C(1.0);
-	result[1] = MFLOAT_C(1.0);
+	return morton_part_1by1((uint32_t)v0[0]) | (morton_part_1by1((uint32_t)v0[1]) << 1);
+}
+
+uint64_t vec2i_to_morton64(mint_t *v0)
+{
+	return morton64_part_1by1((uint32_t)v0[0]) | (morton64_part_1by1((uint32_t)v0[1]) << 1);
+}
+
+uint32_t vec3i_to_morton(mint_t *v0)
+{
+	return morton_part_1by2((uint32_t)v0[0]) | (morton_part_1by2((uint32_t)v0[1]) << 1) | (morton_part_1by2((uint32_t)v0[2]) << 2);
+}
+
+uint64_t vec3i_to_morton64(mint_t *v0)
+{
+	return morton64_part_1by2((uint32_t)v0[0]) | (morton64_part_1by2((uint32_t)v0[1]) << 1) | (morton64_part_1by2((uint32_t)v0[2]) << 2);
+}
+
+mint_t *vec2i_from_morton(mint_t *result, uint32_t code)
+{
+	result[0] = (mint_t)morton_compact_1by1(code);
+	result[1] = (mint_t)morton_compact_1by1(code >> 1);
 	return result;
 }
 
-mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0)
+mint_t *vec2i_from_morton64(mint_t *result, uint64_t code)
 {
-	if (v0[0] > MFLOAT_C(0.0)) {
+	result[0] = (mint_t)morton64_compact_1by1(code);
+	result[1] = (mint_t)morton64_compact_1by1(code >> 1);
+	return result;
+}
+
+mint_t *vec3i_from_morton(mint_t *result, uint32_t code)
+{
+	result[0] = (mint_t)morton_compact_1by2(code);
+	result[1] = (mint_t)morton_compact_1by2(code >> 1);
+	result[2] = (mint_t)morton_compact_1by2(code >> 2);
+	return result;
+}
+
+mint_t *vec3i_from_morton64(mint_t *result, uint64_t code)
+{
+	result[0] = (mint_t)morton64_compact_1by2(code);
+	result[1] = (mint_t)morton64_compact_1by2(code >> 1);
+	result[2] = (mint_t)morton64_compact_1by2(code >> 2);
+	return result;
+}
+
+uint32_t *vec2i_to_morton_n(uint32_t *result, mint_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = vec2i_to_morton(v0 + i * VEC2_SIZE);
+	}
+	return result;
+}
+
+uint64_t *vec2i_to_morton64_n(uint64_t *result, mint_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = vec2i_to_morton64(v0 + i * VEC2_SIZE);
+	}
+	return result;
+}
+
+uint32_t *vec3i_to_morton_n(uint32_t *result, mint_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = vec3i_to_morton(v0 + i * VEC3_SIZE);
+	}
+	return result;
+}
+
+uint64_t *vec3i_to_morton64_n(uint64_t *result, mint_t *v0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = vec3i_to_morton64(v0 + i * VEC3_SIZE);
+	}
+	return result;
+}
+
+mint_t *vec2i_from_morton_n(mint_t *result, uint32_t *c0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		vec2i_from_morton(result + i * VEC2_SIZE, c0[i]);
+	}
+	return result;
+}
+
+mint_t *vec2i_from_morton64_n(mint_t *result, uint64_t *c0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		vec2i_from_morton64(result + i * VEC2_SIZE, c0[i]);
+	}
+	return result;
+}
+
+mint_t *vec3i_from_morton_n(mint_t *result, uint32_t *c0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		vec3i_from_morton(result + i * VEC3_SIZE, c0[i]);
+	}
+	return result;
+}
+
+mint_t *vec3i_from_morton64_n(mint_t *result, uint64_t *c0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		vec3i_from_morton64(result + i * VEC3_SIZE, c0[i]);
+	}
+	return result;
+}
+
+/* Sorts `codes` with a least significant digit radix sort of 8-bit
+digits and writes the sorted order of the original indices to `indices`,
+to reorder other arrays with morton_reorder_n(). The scratch arrays hold
+`count` elements. Digits shared by every code are skipped */
+void morton_sort_n(uint32_t *codes, uint32_t *indices, uint32_t *codes_scratch, uint32_t *indices_scratch, size_t count)
+{
+	size_t histogram[4][256] = {{0}};
+	uint32_t *source_codes = codes;
+	uint32_t *target_codes = codes_scratch;
+	uint32_t *source_indices = indices;
+	uint32_t *target_indices = indices_scratch;
+	for (size_t i = 0; i < count; i++) {
+		indices[i] = (uint32_t)i;
+		for (int p = 0; p < 4; p++) {
+			histogram[p][(codes[i] >> (p * 8)) & 0xff]++;
+		}
+	}
+	for (int p = 0; p < 4 && count > 0; p++) {
+		size_t *offsets = histogram[p];
+		size_t offset = 0;
+		uint32_t *swap_codes;
+		uint32_t *swap_indices;
+		if (offsets[(codes[0] >> (p * 8)) & 0xff] == count) {
+			continue;
+		}
+		for (int d = 0; d < 256; d++) {
+			size_t digit_count = offsets[d];
+			offsets[d] = offset;
+			offset = offset + digit_count;
+		}
+		for (size_t i = 0; i < count; i++) {
+			size_t j = offsets[(source_codes[i] >> (p * 8)) & 0xff]++;
+			target_codes[j] = source_codes[i];
+			target_indices[j] = source_indices[i];
+		}
+		swap_codes = source_codes;
+		source_codes = target_codes;
+		target_codes = swap_codes;
+		swap_indices = source_indices;
+		source_indices = target_indices;
+		target_indices = swap_indices;
+	}
+	if (source_codes != codes) {
+		for (size_t i = 0; i < count; i++) {
+			codes[i] = source_codes[i];
+			indices[i] = source_indices[i];
+		}
+	}
+}
+
+/* As morton_sort_n(), for 64-bit codes */
+void morton64_sort_n(uint64_t *codes, uint32_t *indices, uint64_t *codes_scratch, uint32_t *indices_scratch, size_t count)
+{
+	size_t histogram[8][256] = {{0}};
+	uint64_t *source_codes = codes;
+	uint64_t *target_codes = codes_scratch;
+	uint32_t *source_indices = indices;
+	uint32_t *target_indices = indices_scratch;
+	for (size_t i = 0; i < count; i++) {
+		indices[i] = (uint32_t)i;
+		for (int p = 0; p < 8; p++) {
+			histogram[p][(codes[i] >> (p * 8)) & 0xff]++;
+		}
+	}
+	for (int p = 0; p < 8 && count > 0; p++) {
+		size_t *offsets = histogram[p];
+		size_t offset = 0;
+		uint64_t *swap_codes;
+		uint32_t *swap_indices;
+		if (offsets[(codes[0] >> (p * 8)) & 0xff] == count) {
+			continue;
+		}
+		for (int d = 0; d < 256; d++) {
+			size_t digit_count = offsets[d];
+			offsets[d] = offset;
+			offset = offset + digit_count;
+		}
+		for (size_t i = 0; i < count; i++) {
+			size_t j = offsets[(source_codes[i] >> (p * 8)) & 0xff]++;
+			target_codes[j] = source_codes[i];
+			target_indices[j] = source_indices[i];
+		}
+		swap_codes = source_codes;
+		source_codes = target_codes;
+		target_codes = swap_codes;
+		swap_indices = source_indices;
+		source_indices = target_indices;
+		target_indices = swap_indices;
+	}
+	if (source_codes != codes) {
+		for (size_t i = 0; i < count; i++) {
+			codes[i] = source_codes[i];
+			indices[i] = source_indices[i];
+		}
+	}
+}
+
+#if defined(MATHC_USE_FLOATING_POINT)
+/* Gathers `v0[indices[i]]` to `result[i]`, to apply the order of
+morton_sort_n() to each array of a SoA layout */
+mfloat_t *morton_reorder_n(mfloat_t *result, mfloat_t *v0, uint32_t *indices, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = v0[indices[i]];
+	}
+	return result;
+}
+#endif
+#endif
+
+#if defined(MATHC_USE_FLOATING_POINT)
+bool vec2_is_zero(mfloat_t *v0)
+{
+	return MFABS(v0[0]) < MFLT_EPSILON && MFABS(v0[1]) < MFLT_EPSILON;
+}
+
+bool vec2_is_equal(mfloat_t *v0, mfloat_t *v1)
+{
+	return MFABS(v0[0] - v1[0]) < MFLT_EPSILON && MFABS(v0[1] - v1[1]) < MFLT_EPSILON;
+}
+
+mfloat_t *vec2(mfloat_t *result, mfloat_t x, mfloat_t y)
+{
+	result[0] = x;
+	result[1] = y;
+	return result;
+}
+
+mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	return result;
+}
+
+#if defined(MATHC_USE_INT)
+mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	return result;
+}
+#endif
+
+mfloat_t *vec2_zero(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(0.0);
+	result[1] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *vec2_one(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(1.0);
+	result[1] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0)
+{
+	if (v0[0] > MFLOAT_C(0.0)) {
 		result[0] = MFLOAT_C(1.0);
 	} else if (v0[0] < MFLOAT_C(0.0)) {
 		result[0] = -MFLOAT_C(1.0);
@@ -1268,6 +2543,128 @@ mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 	return result;
 }
 
+static mfloat_t *vec3_multiply_mat3_n_scalar(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[3];
+	mfloat_t m22 = m0[4];
+	mfloat_t m32 = m0[5];
+	mfloat_t m13 = m0[6];
+	mfloat_t m23 = m0[7];
+	mfloat_t m33 = m0[8];
+	for (size_t i = 0; i < count * VEC3_SIZE; i += VEC3_SIZE) {
+		mfloat_t x = v0[i];
+		mfloat_t y = v0[i + 1];
+		mfloat_t z = v0[i + 2];
+		result[i] = m11 * x + m12 * y + m13 * z;
+		result[i + 1] = m21 * x + m22 * y + m23 * z;
+		result[i + 2] = m31 * x + m32 * y + m33 * z;
+	}
+	return result;
+}
+
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 mfloat_t *vec3_multiply_mat3_n_sse2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+	__m128 m11 = _mm_set1_ps(m0[0]);
+	__m128 m21 = _mm_set1_ps(m0[1]);
+	__m128 m31 = _mm_set1_ps(m0[2]);
+	__m128 m12 = _mm_set1_ps(m0[3]);
+	__m128 m22 = _mm_set1_ps(m0[4]);
+	__m128 m32 = _mm_set1_ps(m0[5]);
+	__m128 m13 = _mm_set1_ps(m0[6]);
+	__m128 m23 = _mm_set1_ps(m0[7]);
+	__m128 m33 = _mm_set1_ps(m0[8]);
+	size_t i = 0;
+	/* Four vectors per iteration, transposed to x, y and z registers */
+	for (; i + 4 <= count; i += 4) {
+		mfloat_t *v = v0 + i * VEC3_SIZE;
+		mfloat_t *r = result + i * VEC3_SIZE;
+		__m128 a = _mm_loadu_ps(v);
+		__m128 b = _mm_loadu_ps(v + 4);
+		__m128 c = _mm_loadu_ps(v + 8);
+		__m128 t0 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+		__m128 t1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+		__m128 t2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+		__m128 t3 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+		__m128 x = _mm_shuffle_ps(a, t0, _MM_SHUFFLE(2, 0, 3, 0));
+		__m128 y = _mm_shuffle_ps(t1, t2, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 z = _mm_shuffle_ps(t3, c, _MM_SHUFFLE(3, 0, 2, 0));
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m11, x), _mm_mul_ps(m12, y)), _mm_mul_ps(m13, z));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m21, x), _mm_mul_ps(m22, y)), _mm_mul_ps(m23, z));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m31, x), _mm_mul_ps(m32, y)), _mm_mul_ps(m33, z));
+		__m128 u0 = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 u1 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0));
+		__m128 u2 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 u3 = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 u4 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2));
+		__m128 u5 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+		_mm_storeu_ps(r, _mm_shuffle_ps(u0, u1, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(r + 4, _mm_shuffle_ps(u2, u3, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(r + 8, _mm_shuffle_ps(u4, u5, _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+	vec3_multiply_mat3_n_scalar(result + i * VEC3_SIZE, v0 + i * VEC3_SIZE, m0, count - i);
+	return result;
+}
+#endif
+
+mfloat_t *vec3_multiply_mat3_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->vec3_multiply_mat3_n(result, v0, m0, count);
+#else
+	return vec3_multiply_mat3_n_scalar(result, v0, m0, count);
+#endif
+}
+
+mfloat_t *vec3_multiply_mat3x4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+{
+	mfloat_t x = v0[0];
+	mfloat_t y = v0[1];
+	mfloat_t z = v0[2];
+	result[0] = m0[0] * x + m0[3] * y + m0[6] * z + m0[9];
+	result[1] = m0[1] * x + m0[4] * y + m0[7] * z + m0[10];
+	result[2] = m0[2] * x + m0[5] * y + m0[8] * z + m0[11];
+	return result;
+}
+
+mfloat_t *vec3_multiply_mat3x4_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[3];
+	mfloat_t m22 = m0[4];
+	mfloat_t m32 = m0[5];
+	mfloat_t m13 = m0[6];
+	mfloat_t m23 = m0[7];
+	mfloat_t m33 = m0[8];
+	mfloat_t m14 = m0[9];
+	mfloat_t m24 = m0[10];
+	mfloat_t m34 = m0[11];
+	for (size_t i = 0; i < count * VEC3_SIZE; i += VEC3_SIZE) {
+		mfloat_t x = v0[i];
+		mfloat_t y = v0[i + 1];
+		mfloat_t z = v0[i + 2];
+		result[i] = m11 * x + m12 * y + m13 * z + m14;
+		result[i + 1] = m21 * x + m22 * y + m23 * z + m24;
+		result[i + 2] = m31 * x + m32 * y + m33 * z + m34;
+	}
+	return result;
+}
+
+mfloat_t *vec3_multiply_mat3x4_direction(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+{
+	return vec3_multiply_mat3(result, v0, m0);
+}
+
+mfloat_t *vec3_multiply_mat3x4_direction_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+	return vec3_multiply_mat3_n(result, v0, m0, count);
+}
+
 mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] / v1[0];
@@ -1417,31 +2814,165 @@ mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 	return result;
 }
 
+/* Rotates around the axis `ra` by the angle `f`. The axis does not need to
+be normalized and is not modified. To rotate many vectors by the same axis
+and angle, build the matrix once with `mat3_rotation_axis()` and apply it
+with `vec3_multiply_mat3()` or `vec3_multiply_mat3_n()` */
 mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f)
 {
-	mfloat_t cs;
-	mfloat_t sn;
-	mfloat_t x;
-	mfloat_t y;
-	mfloat_t z;
-	mfloat_t rx;
-	mfloat_t ry;
-	mfloat_t rz;
-	cs = MCOS(f);
-	sn = MSIN(f);
-	x = v0[0];
-	y = v0[1];
-	z = v0[2];
-	vec3_normalize(ra, ra);
-	rx = ra[0];
-	ry = ra[1];
-	rz = ra[2];
-	result[0] = x * (cs + rx * rx * (1 - cs)) + y * (rx * ry * (1 - cs) - rz * sn) + z * (rx * rz * (1 - cs) + ry * sn);
-	result[1] = x * (ry * rx * (1 - cs) + rz * sn) + y * (cs + ry * ry * (1 - cs)) + z * (ry * rz * (1 - cs) - rx * sn);
-	result[2] = x * (rz * rx * (1 - cs) - ry * sn) + y * (rz * ry * (1 - cs) + rx * sn) + z * (cs + rz * rz * (1 - cs));
+	mfloat_t rotation[MAT3_SIZE];
+	mat3_rotation_axis(rotation, ra, f);
+	return vec3_multiply_mat3(result, v0, rotation);
+}
+
+mfloat_t *vec3_rotate_n(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f, size_t count)
+{
+	mfloat_t rotation[MAT3_SIZE];
+	mat3_rotation_axis(rotation, ra, f);
+	return vec3_multiply_mat3_n(result, v0, rotation, count);
+}
+
+/* Rotates by a unit quaternion without building a matrix:
+t = 2 * cross(q.xyz, v)
+v' = v + q.w * t + cross(q.xyz, t) */
+mfloat_t *vec3_rotate_quat(mfloat_t *result, mfloat_t *v0, mfloat_t *q0)
+{
+	mfloat_t x = v0[0];
+	mfloat_t y = v0[1];
+	mfloat_t z = v0[2];
+	mfloat_t tx = MFLOAT_C(2.0) * (q0[1] * z - q0[2] * y);
+	mfloat_t ty = MFLOAT_C(2.0) * (q0[2] * x - q0[0] * z);
+	mfloat_t tz = MFLOAT_C(2.0) * (q0[0] * y - q0[1] * x);
+	result[0] = x + q0[3] * tx + q0[1] * tz - q0[2] * ty;
+	result[1] = y + q0[3] * ty + q0[2] * tx - q0[0] * tz;
+	result[2] = z + q0[3] * tz + q0[0] * ty - q0[1] * tx;
+	return result;
+}
+
+/* Vectors in `v0` and `result` are SoA: the component `k` of the vector
+`i` is at `v0[k * stride + i]`. The vector `i` is rotated by the
+quaternion at `q0 + i * q0_stride`, a stride of 0 rotates every vector
+by the same quaternion */
+static mfloat_t *vec3_rotate_quat_range(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t q0_stride, size_t first, size_t count)
+{
+	for (size_t i = first; i < count; i++) {
+		mfloat_t v[VEC3_SIZE];
+		v[0] = v0[i];
+		v[1] = v0[stride + i];
+		v[2] = v0[stride * 2 + i];
+		vec3_rotate_quat(v, v, q0 + i * q0_stride);
+		result[i] = v[0];
+		result[stride + i] = v[1];
+		result[stride * 2 + i] = v[2];
+	}
 	return result;
 }
 
+static mfloat_t *vec3_rotate_quat_n_scalar(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t q0_stride, size_t count)
+{
+	return vec3_rotate_quat_range(result, v0, stride, q0, q0_stride, 0, count);
+}
+
+#if defined(MATHC_SIMD_SSE2)
+/* Four rotations, `q` holds the x, y, z and w lanes of the quaternions */
+static MATHC_TARGET_SSE2 void vec3_rotate_quat_sse2(mfloat_t *result, mfloat_t *v0, size_t stride, __m128 *q)
+{
+	__m128 x = _mm_loadu_ps(v0);
+	__m128 y = _mm_loadu_ps(v0 + stride);
+	__m128 z = _mm_loadu_ps(v0 + stride * 2);
+	__m128 two = _mm_set1_ps(MFLOAT_C(2.0));
+	__m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q[1], z), _mm_mul_ps(q[2], y)));
+	__m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q[2], x), _mm_mul_ps(q[0], z)));
+	__m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q[0], y), _mm_mul_ps(q[1], x)));
+	_mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(q[3], tx)), _mm_sub_ps(_mm_mul_ps(q[1], tz), _mm_mul_ps(q[2], ty))));
+	_mm_storeu_ps(result + stride, _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(q[3], ty)), _mm_sub_ps(_mm_mul_ps(q[2], tx), _mm_mul_ps(q[0], tz))));
+	_mm_storeu_ps(result + stride * 2, _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(q[3], tz)), _mm_sub_ps(_mm_mul_ps(q[0], ty), _mm_mul_ps(q[1], tx))));
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *vec3_rotate_quat_n_sse2(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t q0_stride, size_t count)
+{
+	__m128 q[QUAT_SIZE];
+	size_t i = 0;
+	for (int j = 0; j < QUAT_SIZE; j++) {
+		q[j] = _mm_set1_ps(q0[j]);
+	}
+	for (; i + 4 <= count; i += 4) {
+		if (q0_stride > 0) {
+			mfloat_t *p = q0 + i * q0_stride;
+			q[0] = _mm_loadu_ps(p);
+			q[1] = _mm_loadu_ps(p + q0_stride);
+			q[2] = _mm_loadu_ps(p + q0_stride * 2);
+			q[3] = _mm_loadu_ps(p + q0_stride * 3);
+			_MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+		}
+		vec3_rotate_quat_sse2(result + i, v0 + i, stride, q);
+	}
+	return vec3_rotate_quat_range(result, v0, stride, q0, q0_stride, i, count);
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 mfloat_t *vec3_rotate_quat_n_avx2(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t q0_stride, size_t count)
+{
+	__m256 q[QUAT_SIZE];
+	__m256 two = _mm256_set1_ps(MFLOAT_C(2.0));
+	size_t i = 0;
+	for (int j = 0; j < QUAT_SIZE; j++) {
+		q[j] = _mm256_set1_ps(q0[j]);
+	}
+	for (; i + 8 <= count; i += 8) {
+		__m256 x = _mm256_loadu_ps(v0 + i);
+		__m256 y = _mm256_loadu_ps(v0 + stride + i);
+		__m256 z = _mm256_loadu_ps(v0 + stride * 2 + i);
+		__m256 tx;
+		__m256 ty;
+		__m256 tz;
+		if (q0_stride > 0) {
+			/* Transposes two blocks of four quaternions into the lanes */
+			mfloat_t *p = q0 + i * q0_stride;
+			__m128 low[QUAT_SIZE];
+			__m128 high[QUAT_SIZE];
+			for (int j = 0; j < QUAT_SIZE; j++) {
+				low[j] = _mm_loadu_ps(p + q0_stride * (size_t)j);
+				high[j] = _mm_loadu_ps(p + q0_stride * (size_t)(j + 4));
+			}
+			_MM_TRANSPOSE4_PS(low[0], low[1], low[2], low[3]);
+			_MM_TRANSPOSE4_PS(high[0], high[1], high[2], high[3]);
+			for (int j = 0; j < QUAT_SIZE; j++) {
+				q[j] = _mm256_insertf128_ps(_mm256_castps128_ps256(low[j]), high[j], 1);
+			}
+		}
+		tx = _mm256_mul_ps(two, _mm256_fmsub_ps(q[1], z, _mm256_mul_ps(q[2], y)));
+		ty = _mm256_mul_ps(two, _mm256_fmsub_ps(q[2], x, _mm256_mul_ps(q[0], z)));
+		tz = _mm256_mul_ps(two, _mm256_fmsub_ps(q[0], y, _mm256_mul_ps(q[1], x)));
+		_mm256_storeu_ps(result + i, _mm256_add_ps(_mm256_fmadd_ps(q[3], tx, x), _mm256_fmsub_ps(q[1], tz, _mm256_mul_ps(q[2], ty))));
+		_mm256_storeu_ps(result + stride + i, _mm256_add_ps(_mm256_fmadd_ps(q[3], ty, y), _mm256_fmsub_ps(q[2], tx, _mm256_mul_ps(q[0], tz))));
+		_mm256_storeu_ps(result + stride * 2 + i, _mm256_add_ps(_mm256_fmadd_ps(q[3], tz, z), _mm256_fmsub_ps(q[0], ty, _mm256_mul_ps(q[1], tx))));
+	}
+	return vec3_rotate_quat_range(result, v0, stride, q0, q0_stride, i, count);
+}
+#endif
+
+/* Rotates `count` SoA vectors by one quaternion, see vec3_rotate_quat_range() */
+mfloat_t *vec3_rotate_quat_n(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->vec3_rotate_quat_n(result, v0, stride, q0, 0, count);
+#else
+	return vec3_rotate_quat_n_scalar(result, v0, stride, q0, 0, count);
+#endif
+}
+
+/* Rotates `count` SoA vectors, each by its quaternion in `q0` */
+mfloat_t *vec3_rotate_quats_n(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->vec3_rotate_quat_n(result, v0, stride, q0, QUAT_SIZE, count);
+#else
+	return vec3_rotate_quat_n_scalar(result, v0, stride, q0, QUAT_SIZE, count);
+#endif
+}
+
 mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
 {
 	result[0] = v0[0] + (v1[0] - v0[0]) * f;
@@ -1686,7 +3217,7 @@ mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+static mfloat_t *vec4_multiply_mat4_scalar(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 {
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
@@ -1699,46 +3230,178 @@ mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+static mfloat_t *vec4_multiply_mat4_n_scalar(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
 {
-	result[0] = v0[0] / v1[0];
-	result[1] = v0[1] / v1[1];
-	result[2] = v0[2] / v1[2];
-	result[3] = v0[3] / v1[3];
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m41 = m0[3];
+	mfloat_t m12 = m0[4];
+	mfloat_t m22 = m0[5];
+	mfloat_t m32 = m0[6];
+	mfloat_t m42 = m0[7];
+	mfloat_t m13 = m0[8];
+	mfloat_t m23 = m0[9];
+	mfloat_t m33 = m0[10];
+	mfloat_t m43 = m0[11];
+	mfloat_t m14 = m0[12];
+	mfloat_t m24 = m0[13];
+	mfloat_t m34 = m0[14];
+	mfloat_t m44 = m0[15];
+	for (size_t i = 0; i < count * VEC4_SIZE; i += VEC4_SIZE) {
+		mfloat_t x = v0[i];
+		mfloat_t y = v0[i + 1];
+		mfloat_t z = v0[i + 2];
+		mfloat_t w = v0[i + 3];
+		result[i] = m11 * x + m12 * y + m13 * z + m14 * w;
+		result[i + 1] = m21 * x + m22 * y + m23 * z + m24 * w;
+		result[i + 2] = m31 * x + m32 * y + m33 * z + m34 * w;
+		result[i + 3] = m41 * x + m42 * y + m43 * z + m44 * w;
+	}
 	return result;
 }
 
-mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 mfloat_t *vec4_multiply_mat4_sse2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 {
-	result[0] = v0[0] / f;
-	result[1] = v0[1] / f;
-	result[2] = v0[2] / f;
-	result[3] = v0[3] / f;
+	__m128 v = _mm_loadu_ps(v0);
+	__m128 r = _mm_mul_ps(_mm_loadu_ps(m0), _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m0 + 4), _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m0 + 8), _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m0 + 12), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+	_mm_storeu_ps(result, r);
 	return result;
 }
 
-mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+static MATHC_TARGET_SSE2 mfloat_t *vec4_multiply_mat4_n_sse2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
 {
-	result[0] = MFLOOR(v0[0] / v1[0]) * v1[0];
-	result[1] = MFLOOR(v0[1] / v1[1]) * v1[1];
-	result[2] = MFLOOR(v0[2] / v1[2]) * v1[2];
-	result[3] = MFLOOR(v0[3] / v1[3]) * v1[3];
+	__m128 c0 = _mm_loadu_ps(m0);
+	__m128 c1 = _mm_loadu_ps(m0 + 4);
+	__m128 c2 = _mm_loadu_ps(m0 + 8);
+	__m128 c3 = _mm_loadu_ps(m0 + 12);
+	for (size_t i = 0; i < count * VEC4_SIZE; i += VEC4_SIZE) {
+		__m128 v = _mm_loadu_ps(v0 + i);
+		__m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+		r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+		r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+		_mm_storeu_ps(result + i, r);
+	}
 	return result;
 }
+#endif
 
-mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
-{
-	result[0] = MFLOOR(v0[0] / f) * f;
-	result[1] = MFLOOR(v0[1] / f) * f;
-	result[2] = MFLOOR(v0[2] / f) * f;
-	result[3] = MFLOOR(v0[3] / f) * f;
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 mfloat_t *vec4_multiply_mat4_n_avx2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+	/* Two vectors per iteration, one in each 128-bit lane */
+	__m256 c0 = _mm256_broadcast_ps((const __m128 *)m0);
+	__m256 c1 = _mm256_broadcast_ps((const __m128 *)(m0 + 4));
+	__m256 c2 = _mm256_broadcast_ps((const __m128 *)(m0 + 8));
+	__m256 c3 = _mm256_broadcast_ps((const __m128 *)(m0 + 12));
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		__m256 v = _mm256_loadu_ps(v0 + i * VEC4_SIZE);
+		__m256 r = _mm256_mul_ps(c0, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm256_fmadd_ps(c1, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = _mm256_fmadd_ps(c2, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = _mm256_fmadd_ps(c3, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		_mm256_storeu_ps(result + i * VEC4_SIZE, r);
+	}
+	if (i < count) {
+		__m128 v = _mm_loadu_ps(v0 + i * VEC4_SIZE);
+		__m128 r = _mm_mul_ps(_mm256_castps256_ps128(c0), _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm_fmadd_ps(_mm256_castps256_ps128(c1), _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = _mm_fmadd_ps(_mm256_castps256_ps128(c2), _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = _mm_fmadd_ps(_mm256_castps256_ps128(c3), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		_mm_storeu_ps(result + i * VEC4_SIZE, r);
+	}
 	return result;
 }
+#endif
 
-mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0)
-{
-	result[0] = -v0[0];
-	result[1] = -v0[1];
+#if defined(MATHC_SIMD_AVX512)
+static MATHC_TARGET_AVX512 mfloat_t *vec4_multiply_mat4_n_avx512(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+	/* Four vectors per iteration, one in each 128-bit lane */
+	__m512 c0 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0));
+	__m512 c1 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0 + 4));
+	__m512 c2 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0 + 8));
+	__m512 c3 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0 + 12));
+	size_t i = 0;
+	while (i < count) {
+		size_t remaining = count - i;
+		__mmask16 mask = remaining >= 4 ? (__mmask16)0xffff : (__mmask16)((1u << (remaining * VEC4_SIZE)) - 1u);
+		__m512 v = _mm512_maskz_loadu_ps(mask, v0 + i * VEC4_SIZE);
+		__m512 r = _mm512_mul_ps(c0, _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm512_fmadd_ps(c1, _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = _mm512_fmadd_ps(c2, _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = _mm512_fmadd_ps(c3, _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		_mm512_mask_storeu_ps(result + i * VEC4_SIZE, mask, r);
+		i += 4;
+	}
+	return result;
+}
+#endif
+
+mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->vec4_multiply_mat4(result, v0, m0);
+#else
+	return vec4_multiply_mat4_scalar(result, v0, m0);
+#endif
+}
+
+mfloat_t *vec4_multiply_mat4_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->vec4_multiply_mat4_n(result, v0, m0, count);
+#else
+	return vec4_multiply_mat4_n_scalar(result, v0, m0, count);
+#endif
+}
+
+mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+{
+	result[0] = v0[0] / v1[0];
+	result[1] = v0[1] / v1[1];
+	result[2] = v0[2] / v1[2];
+	result[3] = v0[3] / v1[3];
+	return result;
+}
+
+mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+{
+	result[0] = v0[0] / f;
+	result[1] = v0[1] / f;
+	result[2] = v0[2] / f;
+	result[3] = v0[3] / f;
+	return result;
+}
+
+mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+{
+	result[0] = MFLOOR(v0[0] / v1[0]) * v1[0];
+	result[1] = MFLOOR(v0[1] / v1[1]) * v1[1];
+	result[2] = MFLOOR(v0[2] / v1[2]) * v1[2];
+	result[3] = MFLOOR(v0[3] / v1[3]) * v1[3];
+	return result;
+}
+
+mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+{
+	result[0] = MFLOOR(v0[0] / f) * f;
+	result[1] = MFLOOR(v0[1] / f) * f;
+	result[2] = MFLOOR(v0[2] / f) * f;
+	result[3] = MFLOOR(v0[3] / f) * f;
+	return result;
+}
+
+mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0)
+{
+	result[0] = -v0[0];
+	result[1] = -v0[1];
 	result[2] = -v0[2];
 	result[3] = -v0[3];
 	return result;
@@ -1870,14 +3533,49 @@ mfloat_t *quat_null(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *quat_multiply(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
+static mfloat_t *quat_multiply_scalar(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
+{
+	mfloat_t x0 = q0[0];
+	mfloat_t y0 = q0[1];
+	mfloat_t z0 = q0[2];
+	mfloat_t w0 = q0[3];
+	mfloat_t x1 = q1[0];
+	mfloat_t y1 = q1[1];
+	mfloat_t z1 = q1[2];
+	mfloat_t w1 = q1[3];
+	result[0] = w0 * x1 + x0 * w1 + y0 * z1 - z0 * y1;
+	result[1] = w0 * y1 + y0 * w1 + z0 * x1 - x0 * z1;
+	result[2] = w0 * z1 + z0 * w1 + x0 * y1 - y0 * x1;
+	result[3] = w0 * w1 - x0 * x1 - y0 * y1 - z0 * z1;
+	return result;
+}
+
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 mfloat_t *quat_multiply_sse2(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
 {
-	result[0] = q0[3] * q1[0] + q0[0] * q1[3] + q0[1] * q1[2] - q0[2] * q1[1];
-	result[1] = q0[3] * q1[1] + q0[1] * q1[3] + q0[2] * q1[0] - q0[0] * q1[2];
-	result[2] = q0[3] * q1[2] + q0[2] * q1[3] + q0[0] * q1[1] - q0[1] * q1[0];
-	result[3] = q0[3] * q1[3] - q0[0] * q1[0] - q0[1] * q1[1] - q0[2] * q1[2];
+	__m128 a = _mm_loadu_ps(q0);
+	__m128 b = _mm_loadu_ps(q1);
+	__m128 sign_w = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+	__m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+	__m128 t0 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 2, 1, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 3, 3)));
+	__m128 t1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 0, 2)));
+	__m128 t2 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 2, 1)));
+	r = _mm_add_ps(r, _mm_xor_ps(t0, sign_w));
+	r = _mm_add_ps(r, _mm_xor_ps(t1, sign_w));
+	r = _mm_sub_ps(r, t2);
+	_mm_storeu_ps(result, r);
 	return result;
 }
+#endif
+
+mfloat_t *quat_multiply(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->quat_multiply(result, q0, q1);
+#else
+	return quat_multiply_scalar(result, q0, q1);
+#endif
+}
 
 mfloat_t *quat_multiply_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
 {
@@ -2007,30 +3705,30 @@ mfloat_t *quat_from_mat4(mfloat_t *result, mfloat_t *m0)
 		mfloat_t sr = MSQRT(scale + MFLOAT_C(1.0));
 		result[3] = sr * MFLOAT_C(0.5);
 		sr = MFLOAT_C(0.5) / sr;
-		result[0] = (m0[9] - m0[6]) * sr;
-		result[1] = (m0[2] - m0[8]) * sr;
-		result[2] = (m0[4] - m0[1]) * sr;
+		result[0] = (m0[6] - m0[9]) * sr;
+		result[1] = (m0[8] - m0[2]) * sr;
+		result[2] = (m0[1] - m0[4]) * sr;
 	} else if ((m0[0] >= m0[5]) && (m0[0] >= m0[10])) {
 		mfloat_t sr = MSQRT(MFLOAT_C(1.0) + m0[0] - m0[5] - m0[10]);
 		mfloat_t half = MFLOAT_C(0.5) / sr;
 		result[0] = MFLOAT_C(0.5) * sr;
 		result[1] = (m0[4] + m0[1]) * half;
 		result[2] = (m0[8] + m0[2]) * half;
-		result[3] = (m0[9] - m0[6]) * half;
+		result[3] = (m0[6] - m0[9]) * half;
 	} else if (m0[5] > m0[10]) {
 		mfloat_t sr = MSQRT(MFLOAT_C(1.0) + m0[5] - m0[0] - m0[10]);
 		mfloat_t half = MFLOAT_C(0.5) / sr;
 		result[0] = (m0[1] + m0[4]) * half;
 		result[1] = MFLOAT_C(0.5) * sr;
 		result[2] = (m0[6] + m0[9]) * half;
-		result[3] = (m0[2] - m0[8]) * half;
+		result[3] = (m0[8] - m0[2]) * half;
 	} else {
 		mfloat_t sr = MSQRT(MFLOAT_C(1.0) + m0[10] - m0[0] - m0[5]);
 		mfloat_t half = MFLOAT_C(0.5) / sr;
 		result[0] = (m0[2] + m0[8]) * half;
 		result[1] = (m0[6] + m0[9]) * half;
 		result[2] = MFLOAT_C(0.5) * sr;
-		result[3] = (m0[4] - m0[1]) * half;
+		result[3] = (m0[1] - m0[4]) * half;
 	}
 	return result;
 }
@@ -2071,6 +3769,208 @@ mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
 	return result;
 }
 
+/* Eberly, "A Fast and Accurate Algorithm for Computing SLERP". The
+coefficients sin(f * theta) / sin(theta) are a series in (cos(theta) - 1)
+truncated to eight terms, the last one scaled by the factor mu = 1.85298109
+published in the paper (mu / 136 and 8 * mu / 17 below). For cos(theta)
+from 0 to 1 (taking the shortest path) and f from 0 to 1 the maximum error
+of the coefficients is 1.9e-5, and about 3e-5 on the components of the
+result for unit quaternions */
+static const mfloat_t quat_slerp_fast_u[8] = {
+	MFLOAT_C(0.333333333333333333),
+	MFLOAT_C(0.1),
+	MFLOAT_C(0.0476190476190476190),
+	MFLOAT_C(0.0277777777777777778),
+	MFLOAT_C(0.0181818181818181818),
+	MFLOAT_C(0.0128205128205128205),
+	MFLOAT_C(0.00952380952380952381),
+	MFLOAT_C(0.0136248609558823529)
+};
+
+static const mfloat_t quat_slerp_fast_v[8] = {
+	MFLOAT_C(0.333333333333333333),
+	MFLOAT_C(0.4),
+	MFLOAT_C(0.428571428571428571),
+	MFLOAT_C(0.444444444444444444),
+	MFLOAT_C(0.454545454545454545),
+	MFLOAT_C(0.461538461538461538),
+	MFLOAT_C(0.466666666666666667),
+	MFLOAT_C(0.871991101176470588)
+};
+
+static mfloat_t quat_slerp_fast_coefficient(mfloat_t f, mfloat_t d_minus_one)
+{
+	mfloat_t f2 = f * f;
+	mfloat_t c = MFLOAT_C(1.0);
+	for (int i = 7; i >= 0; i--) {
+		c = MFLOAT_C(1.0) + (quat_slerp_fast_u[i] * f2 - quat_slerp_fast_v[i]) * d_minus_one * c;
+	}
+	return f * c;
+}
+
+/* Slerp without acos and sin, see quat_slerp_fast_coefficient() */
+mfloat_t *quat_slerp_fast(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
+{
+	mfloat_t d = quat_dot(q0, q1);
+	mfloat_t sign = d < MFLOAT_C(0.0) ? MFLOAT_C(-1.0) : MFLOAT_C(1.0);
+	mfloat_t d_minus_one = d * sign - MFLOAT_C(1.0);
+	mfloat_t f0 = quat_slerp_fast_coefficient(MFLOAT_C(1.0) - f, d_minus_one);
+	mfloat_t f1 = quat_slerp_fast_coefficient(f, d_minus_one) * sign;
+	result[0] = q0[0] * f0 + q1[0] * f1;
+	result[1] = q0[1] * f0 + q1[1] * f1;
+	result[2] = q0[2] * f0 + q1[2] * f1;
+	result[3] = q0[3] * f0 + q1[3] * f1;
+	return result;
+}
+
+static mfloat_t *quat_slerp_fast_n_scalar(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t *f, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		quat_slerp_fast(result + i * QUAT_SIZE, q0 + i * QUAT_SIZE, q1 + i * QUAT_SIZE, f[i]);
+	}
+	return result;
+}
+
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 __m128 quat_slerp_fast_coefficient_sse2(__m128 f, __m128 d_minus_one)
+{
+	__m128 f2 = _mm_mul_ps(f, f);
+	__m128 one = _mm_set1_ps(MFLOAT_C(1.0));
+	__m128 c = one;
+	for (int i = 7; i >= 0; i--) {
+		__m128 b = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(quat_slerp_fast_u[i]), f2), _mm_set1_ps(quat_slerp_fast_v[i]));
+		c = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(b, d_minus_one), c));
+	}
+	return _mm_mul_ps(f, c);
+}
+
+/* Four slerps, with the quaternions transposed into x, y, z and w lanes */
+static MATHC_TARGET_SSE2 void quat_slerp_fast_sse2(__m128 *result, __m128 *a, __m128 *b, __m128 f)
+{
+	__m128 sign_bit = _mm_set1_ps(MFLOAT_C(-0.0));
+	__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+	__m128 sign = _mm_and_ps(d, sign_bit);
+	__m128 d_minus_one = _mm_sub_ps(_mm_andnot_ps(sign_bit, d), _mm_set1_ps(MFLOAT_C(1.0)));
+	__m128 f0 = quat_slerp_fast_coefficient_sse2(_mm_sub_ps(_mm_set1_ps(MFLOAT_C(1.0)), f), d_minus_one);
+	__m128 f1 = _mm_xor_ps(quat_slerp_fast_coefficient_sse2(f, d_minus_one), sign);
+	for (int j = 0; j < QUAT_SIZE; j++) {
+		result[j] = _mm_add_ps(_mm_mul_ps(a[j], f0), _mm_mul_ps(b[j], f1));
+	}
+}
+
+static MATHC_TARGET_SSE2 void quat_load_transposed_sse2(__m128 *result, mfloat_t *q0)
+{
+	result[0] = _mm_loadu_ps(q0);
+	result[1] = _mm_loadu_ps(q0 + 4);
+	result[2] = _mm_loadu_ps(q0 + 8);
+	result[3] = _mm_loadu_ps(q0 + 12);
+	_MM_TRANSPOSE4_PS(result[0], result[1], result[2], result[3]);
+}
+
+static MATHC_TARGET_SSE2 void quat_store_transposed_sse2(mfloat_t *result, __m128 *q)
+{
+	_MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+	_mm_storeu_ps(result, q[0]);
+	_mm_storeu_ps(result + 4, q[1]);
+	_mm_storeu_ps(result + 8, q[2]);
+	_mm_storeu_ps(result + 12, q[3]);
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *quat_slerp_fast_n_sse2(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t *f, size_t count)
+{
+	__m128 a[QUAT_SIZE];
+	__m128 b[QUAT_SIZE];
+	__m128 r[QUAT_SIZE];
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		quat_load_transposed_sse2(a, q0 + i * QUAT_SIZE);
+		quat_load_transposed_sse2(b, q1 + i * QUAT_SIZE);
+		quat_slerp_fast_sse2(r, a, b, _mm_loadu_ps(f + i));
+		quat_store_transposed_sse2(result + i * QUAT_SIZE, r);
+	}
+	quat_slerp_fast_n_scalar(result + i * QUAT_SIZE, q0 + i * QUAT_SIZE, q1 + i * QUAT_SIZE, f + i, count - i);
+	return result;
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 __m256 quat_slerp_fast_coefficient_avx2(__m256 f, __m256 d_minus_one)
+{
+	__m256 f2 = _mm256_mul_ps(f, f);
+	__m256 one = _mm256_set1_ps(MFLOAT_C(1.0));
+	__m256 c = one;
+	for (int i = 7; i >= 0; i--) {
+		__m256 b = _mm256_fmsub_ps(_mm256_set1_ps(quat_slerp_fast_u[i]), f2, _mm256_set1_ps(quat_slerp_fast_v[i]));
+		c = _mm256_fmadd_ps(_mm256_mul_ps(b, d_minus_one), c, one);
+	}
+	return _mm256_mul_ps(f, c);
+}
+
+static MATHC_TARGET_AVX2 void quat_load_transposed_avx2(__m256 *result, mfloat_t *q0)
+{
+	__m128 low[QUAT_SIZE];
+	__m128 high[QUAT_SIZE];
+	quat_load_transposed_sse2(low, q0);
+	quat_load_transposed_sse2(high, q0 + 16);
+	for (int j = 0; j < QUAT_SIZE; j++) {
+		result[j] = _mm256_insertf128_ps(_mm256_castps128_ps256(low[j]), high[j], 1);
+	}
+}
+
+static MATHC_TARGET_AVX2 void quat_store_transposed_avx2(mfloat_t *result, __m256 *q)
+{
+	__m128 low[QUAT_SIZE];
+	__m128 high[QUAT_SIZE];
+	for (int j = 0; j < QUAT_SIZE; j++) {
+		low[j] = _mm256_castps256_ps128(q[j]);
+		high[j] = _mm256_extractf128_ps(q[j], 1);
+	}
+	quat_store_transposed_sse2(result, low);
+	quat_store_transposed_sse2(result + 16, high);
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *quat_slerp_fast_n_avx2(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t *f, size_t count)
+{
+	__m256 sign_bit = _mm256_set1_ps(MFLOAT_C(-0.0));
+	__m256 one = _mm256_set1_ps(MFLOAT_C(1.0));
+	__m256 a[QUAT_SIZE];
+	__m256 b[QUAT_SIZE];
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 t = _mm256_loadu_ps(f + i);
+		__m256 d;
+		__m256 sign;
+		__m256 d_minus_one;
+		__m256 f0;
+		__m256 f1;
+		quat_load_transposed_avx2(a, q0 + i * QUAT_SIZE);
+		quat_load_transposed_avx2(b, q1 + i * QUAT_SIZE);
+		d = _mm256_fmadd_ps(a[3], b[3], _mm256_fmadd_ps(a[2], b[2], _mm256_fmadd_ps(a[1], b[1], _mm256_mul_ps(a[0], b[0]))));
+		sign = _mm256_and_ps(d, sign_bit);
+		d_minus_one = _mm256_sub_ps(_mm256_andnot_ps(sign_bit, d), one);
+		f0 = quat_slerp_fast_coefficient_avx2(_mm256_sub_ps(one, t), d_minus_one);
+		f1 = _mm256_xor_ps(quat_slerp_fast_coefficient_avx2(t, d_minus_one), sign);
+		for (int j = 0; j < QUAT_SIZE; j++) {
+			a[j] = _mm256_fmadd_ps(b[j], f1, _mm256_mul_ps(a[j], f0));
+		}
+		quat_store_transposed_avx2(result + i * QUAT_SIZE, a);
+	}
+	quat_slerp_fast_n_sse2(result + i * QUAT_SIZE, q0 + i * QUAT_SIZE, q1 + i * QUAT_SIZE, f + i, count - i);
+	return result;
+}
+#endif
+
+/* Interpolates `count` pairs of quaternions of `q0` and `q1`, each by its
+factor in `f`, as quat_slerp_fast() */
+mfloat_t *quat_slerp_fast_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t *f, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->quat_slerp_fast_n(result, q0, q1, f, count);
+#else
+	return quat_slerp_fast_n_scalar(result, q0, q1, f, count);
+#endif
+}
+
 mfloat_t quat_length(mfloat_t *q0)
 {
 	return MSQRT(q0[0] * q0[0] + q0[1] * q0[1] + q0[2] * q0[2] + q0[3] * q0[3]);
@@ -2088,6 +3988,207 @@ mfloat_t quat_angle(mfloat_t *q0, mfloat_t *q1)
 	return MACOS(quat_dot(q0, q1) * s);
 }
 
+mfloat_t *dualquat(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
+{
+	result[0] = q0[0];
+	result[1] = q0[1];
+	result[2] = q0[2];
+	result[3] = q0[3];
+	result[4] = q1[0];
+	result[5] = q1[1];
+	result[6] = q1[2];
+	result[7] = q1[3];
+	return result;
+}
+
+mfloat_t *dualquat_assign(mfloat_t *result, mfloat_t *d0)
+{
+	result[0] = d0[0];
+	result[1] = d0[1];
+	result[2] = d0[2];
+	result[3] = d0[3];
+	result[4] = d0[4];
+	result[5] = d0[5];
+	result[6] = d0[6];
+	result[7] = d0[7];
+	return result;
+}
+
+mfloat_t *dualquat_null(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(0.0);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(1.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(0.0);
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *dualquat_from_rotation_translation(mfloat_t *result, mfloat_t *q0, mfloat_t *v0)
+{
+	mfloat_t x = q0[0];
+	mfloat_t y = q0[1];
+	mfloat_t z = q0[2];
+	mfloat_t w = q0[3];
+	mfloat_t tx = v0[0] * MFLOAT_C(0.5);
+	mfloat_t ty = v0[1] * MFLOAT_C(0.5);
+	mfloat_t tz = v0[2] * MFLOAT_C(0.5);
+	result[0] = x;
+	result[1] = y;
+	result[2] = z;
+	result[3] = w;
+	result[4] = tx * w + ty * z - tz * y;
+	result[5] = ty * w + tz * x - tx * z;
+	result[6] = tz * w + tx * y - ty * x;
+	result[7] = -tx * x - ty * y - tz * z;
+	return result;
+}
+
+mfloat_t *dualquat_from_mat4(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t rotation[QUAT_SIZE];
+	mfloat_t translation[VEC3_SIZE];
+	quat_from_mat4(rotation, m0);
+	translation[0] = m0[12];
+	translation[1] = m0[13];
+	translation[2] = m0[14];
+	return dualquat_from_rotation_translation(result, rotation, translation);
+}
+
+mfloat_t *dualquat_multiply(mfloat_t *result, mfloat_t *d0, mfloat_t *d1)
+{
+	mfloat_t multiplied[DUALQUAT_SIZE];
+	mfloat_t tmp[QUAT_SIZE];
+	quat_multiply(multiplied, d0, d1);
+	quat_multiply(multiplied + 4, d0, d1 + 4);
+	quat_multiply(tmp, d0 + 4, d1);
+	multiplied[4] = multiplied[4] + tmp[0];
+	multiplied[5] = multiplied[5] + tmp[1];
+	multiplied[6] = multiplied[6] + tmp[2];
+	multiplied[7] = multiplied[7] + tmp[3];
+	return dualquat_assign(result, multiplied);
+}
+
+mfloat_t *dualquat_conjugate(mfloat_t *result, mfloat_t *d0)
+{
+	result[0] = -d0[0];
+	result[1] = -d0[1];
+	result[2] = -d0[2];
+	result[3] = d0[3];
+	result[4] = -d0[4];
+	result[5] = -d0[5];
+	result[6] = -d0[6];
+	result[7] = d0[7];
+	return result;
+}
+
+mfloat_t *dualquat_normalize(mfloat_t *result, mfloat_t *d0)
+{
+	mfloat_t l = MFLOAT_C(1.0) / MSQRT(d0[0] * d0[0] + d0[1] * d0[1] + d0[2] * d0[2] + d0[3] * d0[3]);
+	mfloat_t rx = d0[0] * l;
+	mfloat_t ry = d0[1] * l;
+	mfloat_t rz = d0[2] * l;
+	mfloat_t rw = d0[3] * l;
+	mfloat_t dx = d0[4] * l;
+	mfloat_t dy = d0[5] * l;
+	mfloat_t dz = d0[6] * l;
+	mfloat_t dw = d0[7] * l;
+	/* Removes the part of the dual that isn't orthogonal to the real */
+	mfloat_t d = rx * dx + ry * dy + rz * dz + rw * dw;
+	result[0] = rx;
+	result[1] = ry;
+	result[2] = rz;
+	result[3] = rw;
+	result[4] = dx - rx * d;
+	result[5] = dy - ry * d;
+	result[6] = dz - rz * d;
+	result[7] = dw - rw * d;
+	return result;
+}
+
+mfloat_t *dualquat_translation(mfloat_t *result, mfloat_t *d0)
+{
+	mfloat_t rx = d0[0];
+	mfloat_t ry = d0[1];
+	mfloat_t rz = d0[2];
+	mfloat_t rw = d0[3];
+	mfloat_t dx = d0[4];
+	mfloat_t dy = d0[5];
+	mfloat_t dz = d0[6];
+	mfloat_t dw = d0[7];
+	result[0] = MFLOAT_C(2.0) * (rw * dx - dw * rx + ry * dz - rz * dy);
+	result[1] = MFLOAT_C(2.0) * (rw * dy - dw * ry + rz * dx - rx * dz);
+	result[2] = MFLOAT_C(2.0) * (rw * dz - dw * rz + rx * dy - ry * dx);
+	return result;
+}
+
+mfloat_t *dualquat_sclerp(mfloat_t *result, mfloat_t *d0, mfloat_t *d1, mfloat_t f)
+{
+	mfloat_t difference[DUALQUAT_SIZE];
+	mfloat_t power[DUALQUAT_SIZE];
+	mfloat_t s;
+	dualquat_conjugate(difference, d0);
+	dualquat_multiply(difference, difference, d1);
+	/* Takes the shortest path */
+	if (difference[3] < MFLOAT_C(0.0)) {
+		for (int i = 0; i < DUALQUAT_SIZE; i++) {
+			difference[i] = -difference[i];
+		}
+	}
+	s = MSQRT(difference[0] * difference[0] + difference[1] * difference[1] + difference[2] * difference[2]);
+	if (s < MFLOAT_C(0.0001)) {
+		/* Nearly a pure translation */
+		power[0] = difference[0] * f;
+		power[1] = difference[1] * f;
+		power[2] = difference[2] * f;
+		power[3] = MFLOAT_C(1.0);
+		power[4] = difference[4] * f;
+		power[5] = difference[5] * f;
+		power[6] = difference[6] * f;
+		power[7] = difference[7] * f;
+		dualquat_normalize(power, power);
+	} else {
+		/* Raises the screw motion to the power f: angle, pitch, axis and moment */
+		mfloat_t half_angle = MACOS(clampf(difference[3], MFLOAT_C(-1.0), MFLOAT_C(1.0)));
+		mfloat_t half_pitch = -difference[7] / s;
+		mfloat_t lx = difference[0] / s;
+		mfloat_t ly = difference[1] / s;
+		mfloat_t lz = difference[2] / s;
+		mfloat_t mx = (difference[4] - lx * half_pitch * difference[3]) / s;
+		mfloat_t my = (difference[5] - ly * half_pitch * difference[3]) / s;
+		mfloat_t mz = (difference[6] - lz * half_pitch * difference[3]) / s;
+		mfloat_t sin_angle;
+		mfloat_t cos_angle;
+		half_angle = half_angle * f;
+		half_pitch = half_pitch * f;
+		sin_angle = MSIN(half_angle);
+		cos_angle = MCOS(half_angle);
+		power[0] = lx * sin_angle;
+		power[1] = ly * sin_angle;
+		power[2] = lz * sin_angle;
+		power[3] = cos_angle;
+		power[4] = mx * sin_angle + lx * half_pitch * cos_angle;
+		power[5] = my * sin_angle + ly * half_pitch * cos_angle;
+		power[6] = mz * sin_angle + lz * half_pitch * cos_angle;
+		power[7] = -half_pitch * sin_angle;
+	}
+	return dualquat_multiply(result, d0, power);
+}
+
+mfloat_t *mat4_from_dualquat(mfloat_t *result, mfloat_t *d0)
+{
+	mfloat_t translation[VEC3_SIZE];
+	dualquat_translation(translation, d0);
+	mat4_rotation_quat(result, d0);
+	result[12] = translation[0];
+	result[13] = translation[1];
+	result[14] = translation[2];
+	return result;
+}
+
 mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22)
 {
 	result[0] = m11;
@@ -2465,7 +4566,50 @@ mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 
 mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0)
 {
-	result = m0;
+	mfloat_t inverse[MAT3_SIZE];
+	mfloat_t inverted_determinant;
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[3];
+	mfloat_t m22 = m0[4];
+	mfloat_t m32 = m0[5];
+	mfloat_t m13 = m0[6];
+	mfloat_t m23 = m0[7];
+	mfloat_t m33 = m0[8];
+	inverse[0] = m22 * m33 - m23 * m32;
+	inverse[1] = m23 * m31 - m21 * m33;
+	inverse[2] = m21 * m32 - m22 * m31;
+	inverse[3] = m13 * m32 - m12 * m33;
+	inverse[4] = m11 * m33 - m13 * m31;
+	inverse[5] = m12 * m31 - m11 * m32;
+	inverse[6] = m12 * m23 - m13 * m22;
+	inverse[7] = m13 * m21 - m11 * m23;
+	inverse[8] = m11 * m22 - m12 * m21;
+	inverted_determinant = MFLOAT_C(1.0) / (m11 * inverse[0] + m12 * inverse[1] + m13 * inverse[2]);
+	result[0] = inverse[0] * inverted_determinant;
+	result[1] = inverse[1] * inverted_determinant;
+	result[2] = inverse[2] * inverted_determinant;
+	result[3] = inverse[3] * inverted_determinant;
+	result[4] = inverse[4] * inverted_determinant;
+	result[5] = inverse[5] * inverted_determinant;
+	result[6] = inverse[6] * inverted_determinant;
+	result[7] = inverse[7] * inverted_determinant;
+	result[8] = inverse[8] * inverted_determinant;
+	return result;
+}
+
+/* Inverse of an orthonormal (rotation) matrix, which is its transpose */
+mfloat_t *mat3_inverse_rigid(mfloat_t *result, mfloat_t *m0)
+{
+	return mat3_transpose(result, m0);
+}
+
+mfloat_t *mat3_inverse_rigid_n(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+	for (size_t i = 0; i < count * MAT3_SIZE; i += MAT3_SIZE) {
+		mat3_transpose(result + i, m0 + i);
+	}
 	return result;
 }
 
@@ -2524,8 +4668,8 @@ mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	mfloat_t s = MSIN(f);
 	mfloat_t one_c = MFLOAT_C(1.0) - c;
 	mfloat_t x = v0[0];
-	mfloat_t y = v0[4];
-	mfloat_t z = v0[8];
+	mfloat_t y = v0[1];
+	mfloat_t z = v0[2];
 	mfloat_t xx = x * x;
 	mfloat_t xy = x * y;
 	mfloat_t xz = x * z;
@@ -3124,7 +5268,7 @@ mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+static mfloat_t *mat4_multiply_scalar(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 {
 	mfloat_t multiplied[MAT4_SIZE];
 	multiplied[0] = m0[0] * m1[0] + m0[4] * m1[1] + m0[8] * m1[2] + m0[12] * m1[3];
@@ -3162,6 +5306,92 @@ mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 	return result;
 }
 
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 mfloat_t *mat4_multiply_sse2(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+{
+	__m128 c0 = _mm_loadu_ps(m0);
+	__m128 c1 = _mm_loadu_ps(m0 + 4);
+	__m128 c2 = _mm_loadu_ps(m0 + 8);
+	__m128 c3 = _mm_loadu_ps(m0 + 12);
+	__m128 b0 = _mm_loadu_ps(m1);
+	__m128 b1 = _mm_loadu_ps(m1 + 4);
+	__m128 b2 = _mm_loadu_ps(m1 + 8);
+	__m128 b3 = _mm_loadu_ps(m1 + 12);
+	__m128 r0 = _mm_mul_ps(c0, _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m128 r1 = _mm_mul_ps(c0, _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m128 r2 = _mm_mul_ps(c0, _mm_shuffle_ps(b2, b2, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m128 r3 = _mm_mul_ps(c0, _mm_shuffle_ps(b3, b3, _MM_SHUFFLE(0, 0, 0, 0)));
+	r0 = _mm_add_ps(r0, _mm_mul_ps(c1, _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(1, 1, 1, 1))));
+	r1 = _mm_add_ps(r1, _mm_mul_ps(c1, _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(1, 1, 1, 1))));
+	r2 = _mm_add_ps(r2, _mm_mul_ps(c1, _mm_shuffle_ps(b2, b2, _MM_SHUFFLE(1, 1, 1, 1))));
+	r3 = _mm_add_ps(r3, _mm_mul_ps(c1, _mm_shuffle_ps(b3, b3, _MM_SHUFFLE(1, 1, 1, 1))));
+	r0 = _mm_add_ps(r0, _mm_mul_ps(c2, _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(2, 2, 2, 2))));
+	r1 = _mm_add_ps(r1, _mm_mul_ps(c2, _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(2, 2, 2, 2))));
+	r2 = _mm_add_ps(r2, _mm_mul_ps(c2, _mm_shuffle_ps(b2, b2, _MM_SHUFFLE(2, 2, 2, 2))));
+	r3 = _mm_add_ps(r3, _mm_mul_ps(c2, _mm_shuffle_ps(b3, b3, _MM_SHUFFLE(2, 2, 2, 2))));
+	r0 = _mm_add_ps(r0, _mm_mul_ps(c3, _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(3, 3, 3, 3))));
+	r1 = _mm_add_ps(r1, _mm_mul_ps(c3, _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(3, 3, 3, 3))));
+	r2 = _mm_add_ps(r2, _mm_mul_ps(c3, _mm_shuffle_ps(b2, b2, _MM_SHUFFLE(3, 3, 3, 3))));
+	r3 = _mm_add_ps(r3, _mm_mul_ps(c3, _mm_shuffle_ps(b3, b3, _MM_SHUFFLE(3, 3, 3, 3))));
+	_mm_storeu_ps(result, r0);
+	_mm_storeu_ps(result + 4, r1);
+	_mm_storeu_ps(result + 8, r2);
+	_mm_storeu_ps(result + 12, r3);
+	return result;
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 mfloat_t *mat4_multiply_avx2(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+{
+	/* Each 256-bit register holds two columns of the result */
+	__m256 c0 = _mm256_broadcast_ps((const __m128 *)m0);
+	__m256 c1 = _mm256_broadcast_ps((const __m128 *)(m0 + 4));
+	__m256 c2 = _mm256_broadcast_ps((const __m128 *)(m0 + 8));
+	__m256 c3 = _mm256_broadcast_ps((const __m128 *)(m0 + 12));
+	__m256 b01 = _mm256_loadu_ps(m1);
+	__m256 b23 = _mm256_loadu_ps(m1 + 8);
+	__m256 r01 = _mm256_mul_ps(c0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m256 r23 = _mm256_mul_ps(c0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0)));
+	r01 = _mm256_fmadd_ps(c1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+	r23 = _mm256_fmadd_ps(c1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+	r01 = _mm256_fmadd_ps(c2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+	r23 = _mm256_fmadd_ps(c2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+	r01 = _mm256_fmadd_ps(c3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+	r23 = _mm256_fmadd_ps(c3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+	_mm256_storeu_ps(result, r01);
+	_mm256_storeu_ps(result + 8, r23);
+	return result;
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX512)
+static MATHC_TARGET_AVX512 mfloat_t *mat4_multiply_avx512(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+{
+	/* Each 128-bit lane holds one column of the result */
+	__m512 c0 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0));
+	__m512 c1 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0 + 4));
+	__m512 c2 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0 + 8));
+	__m512 c3 = _mm512_broadcast_f32x4(_mm_loadu_ps(m0 + 12));
+	__m512 b = _mm512_loadu_ps(m1);
+	__m512 r = _mm512_mul_ps(c0, _mm512_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = _mm512_fmadd_ps(c1, _mm512_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+	r = _mm512_fmadd_ps(c2, _mm512_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+	r = _mm512_fmadd_ps(c3, _mm512_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3)), r);
+	_mm512_storeu_ps(result, r);
+	return result;
+}
+#endif
+
+mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->mat4_multiply(result, m0, m1);
+#else
+	return mat4_multiply_scalar(result, m0, m1);
+#endif
+}
+
 mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 {
 	result[0] = m0[0] * f;
@@ -3183,7 +5413,7 @@ mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0)
+static mfloat_t *mat4_inverse_scalar(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t inverse[MAT4_SIZE];
 	mfloat_t inverted_determinant;
@@ -3319,146 +5549,3488 @@ mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
+static mfloat_t *mat4_inverse_n_scalar(mfloat_t *result, mfloat_t *m0, size_t count)
 {
-	result[0] = m0[0] + (m1[0] - m0[0]) * f;
-	result[1] = m0[1] + (m1[1] - m0[1]) * f;
-	result[2] = m0[2] + (m1[2] - m0[2]) * f;
-	result[3] = m0[3] + (m1[3] - m0[3]) * f;
-	result[4] = m0[4] + (m1[4] - m0[4]) * f;
-	result[5] = m0[5] + (m1[5] - m0[5]) * f;
-	result[6] = m0[6] + (m1[6] - m0[6]) * f;
-	result[7] = m0[7] + (m1[7] - m0[7]) * f;
-	result[8] = m0[8] + (m1[8] - m0[8]) * f;
-	result[9] = m0[9] + (m1[9] - m0[9]) * f;
-	result[10] = m0[10] + (m1[10] - m0[10]) * f;
-	result[11] = m0[11] + (m1[11] - m0[11]) * f;
-	result[12] = m0[12] + (m1[12] - m0[12]) * f;
-	result[13] = m0[13] + (m1[13] - m0[13]) * f;
-	result[14] = m0[14] + (m1[14] - m0[14]) * f;
-	result[15] = m0[15] + (m1[15] - m0[15]) * f;
+	for (size_t i = 0; i < count * MAT4_SIZE; i += MAT4_SIZE) {
+		mat4_inverse_scalar(result + i, m0 + i);
+	}
+	return result;
+}
+
+/*
+The SIMD inverses use the block formulation: the matrix is split in four
+2×2 blocks, each held in one register, and the inverse is built from the
+adjugates and determinants of the blocks. The columns are processed as if
+they were rows, which gives the transposed inverse of the transposed
+matrix, i.e. the inverse.
+*/
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 __m128 mat2_multiply_sse2(__m128 a, __m128 b)
+{
+	return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+static MATHC_TARGET_SSE2 __m128 mat2_adjugate_multiply_sse2(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+static MATHC_TARGET_SSE2 __m128 mat2_multiply_adjugate_sse2(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+static MATHC_TARGET_SSE2 void mat4_inverse_columns_sse2(__m128 *c)
+{
+	__m128 a = _mm_shuffle_ps(c[0], c[1], _MM_SHUFFLE(1, 0, 1, 0));
+	__m128 b = _mm_shuffle_ps(c[0], c[1], _MM_SHUFFLE(3, 2, 3, 2));
+	__m128 cc = _mm_shuffle_ps(c[2], c[3], _MM_SHUFFLE(1, 0, 1, 0));
+	__m128 d = _mm_shuffle_ps(c[2], c[3], _MM_SHUFFLE(3, 2, 3, 2));
+	__m128 determinants = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(c[0], c[2], _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c[1], c[3], _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(c[0], c[2], _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c[1], c[3], _MM_SHUFFLE(2, 0, 2, 0))));
+	__m128 det_a = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 det_b = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 det_c = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 det_d = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(3, 3, 3, 3));
+	__m128 d_c = mat2_adjugate_multiply_sse2(d, cc);
+	__m128 a_b = mat2_adjugate_multiply_sse2(a, b);
+	__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_multiply_sse2(b, d_c));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_multiply_sse2(cc, a_b));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, cc), mat2_multiply_adjugate_sse2(d, a_b));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_multiply_adjugate_sse2(a, d_c));
+	__m128 determinant = _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c));
+	__m128 trace = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+	__m128 inverted_determinant;
+	trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+	trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+	determinant = _mm_sub_ps(determinant, trace);
+	inverted_determinant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+	x = _mm_mul_ps(x, inverted_determinant);
+	y = _mm_mul_ps(y, inverted_determinant);
+	z = _mm_mul_ps(z, inverted_determinant);
+	w = _mm_mul_ps(w, inverted_determinant);
+	c[0] = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3));
+	c[1] = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2));
+	c[2] = _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3));
+	c[3] = _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2));
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *mat4_inverse_sse2(mfloat_t *result, mfloat_t *m0)
+{
+	__m128 c[4];
+	c[0] = _mm_loadu_ps(m0);
+	c[1] = _mm_loadu_ps(m0 + 4);
+	c[2] = _mm_loadu_ps(m0 + 8);
+	c[3] = _mm_loadu_ps(m0 + 12);
+	mat4_inverse_columns_sse2(c);
+	_mm_storeu_ps(result, c[0]);
+	_mm_storeu_ps(result + 4, c[1]);
+	_mm_storeu_ps(result + 8, c[2]);
+	_mm_storeu_ps(result + 12, c[3]);
+	return result;
+}
+
+static MATHC_TARGET_SSE2 mfloat_t *mat4_inverse_n_sse2(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+	for (size_t i = 0; i < count * MAT4_SIZE; i += MAT4_SIZE) {
+		mat4_inverse_sse2(result + i, m0 + i);
+	}
 	return result;
 }
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 __m256 mat2_multiply_avx2(__m256 a, __m256 b)
+{
+	return _mm256_fmadd_ps(a, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0)),
+		_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+static MATHC_TARGET_AVX2 __m256 mat2_adjugate_multiply_avx2(__m256 a, __m256 b)
+{
+	return _mm256_fmsub_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b,
+		_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+static MATHC_TARGET_AVX2 __m256 mat2_multiply_adjugate_avx2(__m256 a, __m256 b)
+{
+	return _mm256_fmsub_ps(a, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3)),
+		_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+/* Inverts two matrices at once, one in each 128-bit lane */
+static MATHC_TARGET_AVX2 void mat4_inverse_columns_avx2(__m256 *c)
+{
+	__m256 a = _mm256_shuffle_ps(c[0], c[1], _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 b = _mm256_shuffle_ps(c[0], c[1], _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 cc = _mm256_shuffle_ps(c[2], c[3], _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 d = _mm256_shuffle_ps(c[2], c[3], _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 determinants = _mm256_fmsub_ps(_mm256_shuffle_ps(c[0], c[2], _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_ps(c[1], c[3], _MM_SHUFFLE(3, 1, 3, 1)),
+		_mm256_mul_ps(_mm256_shuffle_ps(c[0], c[2], _MM_SHUFFLE(3, 1, 3, 1)), _mm256_shuffle_ps(c[1], c[3], _MM_SHUFFLE(2, 0, 2, 0))));
+	__m256 det_a = _mm256_shuffle_ps(determinants, determinants, _MM_SHUFFLE(0, 0, 0, 0));
+	__m256 det_b = _mm256_shuffle_ps(determinants, determinants, _MM_SHUFFLE(1, 1, 1, 1));
+	__m256 det_c = _mm256_shuffle_ps(determinants, determinants, _MM_SHUFFLE(2, 2, 2, 2));
+	__m256 det_d = _mm256_shuffle_ps(determinants, determinants, _MM_SHUFFLE(3, 3, 3, 3));
+	__m256 d_c = mat2_adjugate_multiply_avx2(d, cc);
+	__m256 a_b = mat2_adjugate_multiply_avx2(a, b);
+	__m256 x = _mm256_fmsub_ps(det_d, a, mat2_multiply_avx2(b, d_c));
+	__m256 w = _mm256_fmsub_ps(det_a, d, mat2_multiply_avx2(cc, a_b));
+	__m256 y = _mm256_fmsub_ps(det_b, cc, mat2_multiply_adjugate_avx2(d, a_b));
+	__m256 z = _mm256_fmsub_ps(det_c, b, mat2_multiply_adjugate_avx2(a, d_c));
+	__m256 determinant = _mm256_fmadd_ps(det_a, det_d, _mm256_mul_ps(det_b, det_c));
+	__m256 trace = _mm256_mul_ps(a_b, _mm256_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+	__m256 inverted_determinant;
+	trace = _mm256_add_ps(trace, _mm256_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+	trace = _mm256_add_ps(trace, _mm256_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+	determinant = _mm256_sub_ps(determinant, trace);
+	inverted_determinant = _mm256_div_ps(_mm256_setr_ps(1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f), determinant);
+	x = _mm256_mul_ps(x, inverted_determinant);
+	y = _mm256_mul_ps(y, inverted_determinant);
+	z = _mm256_mul_ps(z, inverted_determinant);
+	w = _mm256_mul_ps(w, inverted_determinant);
+	c[0] = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3));
+	c[1] = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2));
+	c[2] = _mm256_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3));
+	c[3] = _mm256_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2));
+}
+
+static MATHC_TARGET_AVX2 mfloat_t *mat4_inverse_n_avx2(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		mfloat_t *m = m0 + i * MAT4_SIZE;
+		mfloat_t *r = result + i * MAT4_SIZE;
+		__m256 c[4];
+		c[0] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m)), _mm_loadu_ps(m + 16), 1);
+		c[1] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m + 4)), _mm_loadu_ps(m + 20), 1);
+		c[2] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m + 8)), _mm_loadu_ps(m + 24), 1);
+		c[3] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m + 12)), _mm_loadu_ps(m + 28), 1);
+		mat4_inverse_columns_avx2(c);
+		_mm_storeu_ps(r, _mm256_castps256_ps128(c[0]));
+		_mm_storeu_ps(r + 4, _mm256_castps256_ps128(c[1]));
+		_mm_storeu_ps(r + 8, _mm256_castps256_ps128(c[2]));
+		_mm_storeu_ps(r + 12, _mm256_castps256_ps128(c[3]));
+		_mm_storeu_ps(r + 16, _mm256_extractf128_ps(c[0], 1));
+		_mm_storeu_ps(r + 20, _mm256_extractf128_ps(c[1], 1));
+		_mm_storeu_ps(r + 24, _mm256_extractf128_ps(c[2], 1));
+		_mm_storeu_ps(r + 28, _mm256_extractf128_ps(c[3], 1));
+	}
+	if (i < count) {
+		mat4_inverse_sse2(result + i * MAT4_SIZE, m0 + i * MAT4_SIZE);
+	}
+	return result;
+}
+#endif
+
+mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->mat4_inverse(result, m0);
+#else
+	return mat4_inverse_scalar(result, m0);
+#endif
+}
+
+mfloat_t *mat4_inverse_n(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->mat4_inverse_n(result, m0, count);
+#else
+	return mat4_inverse_n_scalar(result, m0, count);
+#endif
+}
+
+/* Inverse of a matrix whose last row is 0 0 0 1 */
+mfloat_t *mat4_inverse_affine(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t inverse[MAT3_SIZE];
+	mfloat_t inverted_determinant;
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[4];
+	mfloat_t m22 = m0[5];
+	mfloat_t m32 = m0[6];
+	mfloat_t m13 = m0[8];
+	mfloat_t m23 = m0[9];
+	mfloat_t m33 = m0[10];
+	mfloat_t m14 = m0[12];
+	mfloat_t m24 = m0[13];
+	mfloat_t m34 = m0[14];
+	inverse[0] = m22 * m33 - m23 * m32;
+	inverse[1] = m23 * m31 - m21 * m33;
+	inverse[2] = m21 * m32 - m22 * m31;
+	inverse[3] = m13 * m32 - m12 * m33;
+	inverse[4] = m11 * m33 - m13 * m31;
+	inverse[5] = m12 * m31 - m11 * m32;
+	inverse[6] = m12 * m23 - m13 * m22;
+	inverse[7] = m13 * m21 - m11 * m23;
+	inverse[8] = m11 * m22 - m12 * m21;
+	inverted_determinant = MFLOAT_C(1.0) / (m11 * inverse[0] + m12 * inverse[1] + m13 * inverse[2]);
+	result[0] = inverse[0] * inverted_determinant;
+	result[1] = inverse[1] * inverted_determinant;
+	result[2] = inverse[2] * inverted_determinant;
+	result[3] = MFLOAT_C(0.0);
+	result[4] = inverse[3] * inverted_determinant;
+	result[5] = inverse[4] * inverted_determinant;
+	result[6] = inverse[5] * inverted_determinant;
+	result[7] = MFLOAT_C(0.0);
+	result[8] = inverse[6] * inverted_determinant;
+	result[9] = inverse[7] * inverted_determinant;
+	result[10] = inverse[8] * inverted_determinant;
+	result[11] = MFLOAT_C(0.0);
+	result[12] = -(result[0] * m14 + result[4] * m24 + result[8] * m34);
+	result[13] = -(result[1] * m14 + result[5] * m24 + result[9] * m34);
+	result[14] = -(result[2] * m14 + result[6] * m24 + result[10] * m34);
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *mat4_inverse_affine_n(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+	for (size_t i = 0; i < count * MAT4_SIZE; i += MAT4_SIZE) {
+		mat4_inverse_affine(result + i, m0 + i);
+	}
+	return result;
+}
+
+/* Inverse of a rotation followed by a translation, without scaling */
+mfloat_t *mat4_inverse_rigid(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[4];
+	mfloat_t m22 = m0[5];
+	mfloat_t m32 = m0[6];
+	mfloat_t m13 = m0[8];
+	mfloat_t m23 = m0[9];
+	mfloat_t m33 = m0[10];
+	mfloat_t m14 = m0[12];
+	mfloat_t m24 = m0[13];
+	mfloat_t m34 = m0[14];
+	result[0] = m11;
+	result[1] = m12;
+	result[2] = m13;
+	result[3] = MFLOAT_C(0.0);
+	result[4] = m21;
+	result[5] = m22;
+	result[6] = m23;
+	result[7] = MFLOAT_C(0.0);
+	result[8] = m31;
+	result[9] = m32;
+	result[10] = m33;
+	result[11] = MFLOAT_C(0.0);
+	result[12] = -(m11 * m14 + m21 * m24 + m31 * m34);
+	result[13] = -(m12 * m14 + m22 * m24 + m32 * m34);
+	result[14] = -(m13 * m14 + m23 * m24 + m33 * m34);
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *mat4_inverse_rigid_n(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+	for (size_t i = 0; i < count * MAT4_SIZE; i += MAT4_SIZE) {
+		mat4_inverse_rigid(result + i, m0 + i);
+	}
+	return result;
+}
+
+mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
+{
+	result[0] = m0[0] + (m1[0] - m0[0]) * f;
+	result[1] = m0[1] + (m1[1] - m0[1]) * f;
+	result[2] = m0[2] + (m1[2] - m0[2]) * f;
+	result[3] = m0[3] + (m1[3] - m0[3]) * f;
+	result[4] = m0[4] + (m1[4] - m0[4]) * f;
+	result[5] = m0[5] + (m1[5] - m0[5]) * f;
+	result[6] = m0[6] + (m1[6] - m0[6]) * f;
+	result[7] = m0[7] + (m1[7] - m0[7]) * f;
+	result[8] = m0[8] + (m1[8] - m0[8]) * f;
+	result[9] = m0[9] + (m1[9] - m0[9]) * f;
+	result[10] = m0[10] + (m1[10] - m0[10]) * f;
+	result[11] = m0[11] + (m1[11] - m0[11]) * f;
+	result[12] = m0[12] + (m1[12] - m0[12]) * f;
+	result[13] = m0[13] + (m1[13] - m0[13]) * f;
+	result[14] = m0[14] + (m1[14] - m0[14]) * f;
+	result[15] = m0[15] + (m1[15] - m0[15]) * f;
+	return result;
+}
+
+mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up)
+{
+	mfloat_t tmp_forward[VEC3_SIZE];
+	mfloat_t tmp_side[VEC3_SIZE];
+	mfloat_t tmp_up[VEC3_SIZE];
+	vec3_subtract(tmp_forward, target, position);
+	vec3_normalize(tmp_forward, tmp_forward);
+	vec3_cross(tmp_side, tmp_forward, up);
+	vec3_normalize(tmp_side, tmp_side);
+	vec3_cross(tmp_up, tmp_side, tmp_forward);
+	result[0] = tmp_side[0];
+	result[1] = tmp_up[0];
+	result[2] = -tmp_forward[0];
+	result[3] = MFLOAT_C(0.0);
+	result[4] = tmp_side[1];
+	result[5] = tmp_up[1];
+	result[6] = -tmp_forward[1];
+	result[7] = MFLOAT_C(0.0);
+	result[8] = tmp_side[2];
+	result[9] = tmp_up[2];
+	result[10] = -tmp_forward[2];
+	result[11] = MFLOAT_C(0.0);
+	result[12] = -vec3_dot(tmp_side, position);
+	result[13] = -vec3_dot(tmp_up, position);
+	result[14] = vec3_dot(tmp_forward, position);
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f)
+{
+	result[0] = MFLOAT_C(2.0) / (r - l);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(2.0) / (t - b);
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(0.0);
+	result[9] = MFLOAT_C(0.0);
+	result[10] = -MFLOAT_C(2.0) / (f - n);
+	result[11] = MFLOAT_C(0.0);
+	result[12] = -((r + l) / (r - l));
+	result[13] = -((t + b) / (t - b));
+	result[14] = -((f + n) / (f - n));
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f)
+{
+	mfloat_t tan_half_fov_y = MFLOAT_C(1.0) / MTAN(fov_y * MFLOAT_C(0.5));
+	result[0] = MFLOAT_C(1.0) / aspect * tan_half_fov_y;
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(1.0) / tan_half_fov_y;
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(0.0);
+	result[9] = MFLOAT_C(0.0);
+	result[10] = f / (n - f);
+	result[11] = -MFLOAT_C(1.0);
+	result[12] = MFLOAT_C(0.0);
+	result[13] = MFLOAT_C(0.0);
+	result[14] = -(f * n) / (f - n);
+	result[15] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f)
+{
+	mfloat_t h2 = MCOS(fov * MFLOAT_C(0.5)) / MSIN(fov * MFLOAT_C(0.5));
+	mfloat_t w2 = h2 * h / w;
+	result[0] = w2;
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = h2;
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(0.0);
+	result[9] = MFLOAT_C(0.0);
+	result[10] = f / (n - f);
+	result[11] = -MFLOAT_C(1.0);
+	result[12] = MFLOAT_C(0.0);
+	result[13] = MFLOAT_C(0.0);
+	result[14] = -(f * n) / (f - n);
+	result[15] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n)
+{
+	mfloat_t range = MTAN(fov_y * MFLOAT_C(0.5)) * n;
+	mfloat_t left = -range * aspect;
+	mfloat_t right = range * aspect;
+	mfloat_t top = range;
+	mfloat_t bottom = -range;
+	result[0] = MFLOAT_C(2.0) * n / (right - left);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(2.0) * n / (top - bottom);
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(0.0);
+	result[9] = MFLOAT_C(0.0);
+	result[10] = -MFLOAT_C(1.0);
+	result[11] = -MFLOAT_C(1.0);
+	result[12] = MFLOAT_C(0.0);
+	result[13] = MFLOAT_C(0.0);
+	result[14] = -MFLOAT_C(2.0) * n;
+	result[15] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *mat4_assign_mat3x4(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t assigned[MAT3X4_SIZE];
+	assigned[0] = m0[0];
+	assigned[1] = m0[1];
+	assigned[2] = m0[2];
+	assigned[3] = m0[3];
+	assigned[4] = m0[4];
+	assigned[5] = m0[5];
+	assigned[6] = m0[6];
+	assigned[7] = m0[7];
+	assigned[8] = m0[8];
+	assigned[9] = m0[9];
+	assigned[10] = m0[10];
+	assigned[11] = m0[11];
+	result[0] = assigned[0];
+	result[1] = assigned[1];
+	result[2] = assigned[2];
+	result[3] = MFLOAT_C(0.0);
+	result[4] = assigned[3];
+	result[5] = assigned[4];
+	result[6] = assigned[5];
+	result[7] = MFLOAT_C(0.0);
+	result[8] = assigned[6];
+	result[9] = assigned[7];
+	result[10] = assigned[8];
+	result[11] = MFLOAT_C(0.0);
+	result[12] = assigned[9];
+	result[13] = assigned[10];
+	result[14] = assigned[11];
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *mat3x4(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34)
+{
+	result[0] = m11;
+	result[1] = m21;
+	result[2] = m31;
+	result[3] = m12;
+	result[4] = m22;
+	result[5] = m32;
+	result[6] = m13;
+	result[7] = m23;
+	result[8] = m33;
+	result[9] = m14;
+	result[10] = m24;
+	result[11] = m34;
+	return result;
+}
+
+mfloat_t *mat3x4_zero(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(0.0);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(0.0);
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(0.0);
+	result[9] = MFLOAT_C(0.0);
+	result[10] = MFLOAT_C(0.0);
+	result[11] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *mat3x4_identity(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(1.0);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(1.0);
+	result[5] = MFLOAT_C(0.0);
+	result[6] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(1.0);
+	result[9] = MFLOAT_C(0.0);
+	result[10] = MFLOAT_C(0.0);
+	result[11] = MFLOAT_C(0.0);
+	return result;
+}
+
+mfloat_t *mat3x4_assign(mfloat_t *result, mfloat_t *m0)
+{
+	result[0] = m0[0];
+	result[1] = m0[1];
+	result[2] = m0[2];
+	result[3] = m0[3];
+	result[4] = m0[4];
+	result[5] = m0[5];
+	result[6] = m0[6];
+	result[7] = m0[7];
+	result[8] = m0[8];
+	result[9] = m0[9];
+	result[10] = m0[10];
+	result[11] = m0[11];
+	return result;
+}
+
+mfloat_t *mat3x4_assign_mat4(mfloat_t *result, mfloat_t *m0)
+{
+	result[0] = m0[0];
+	result[1] = m0[1];
+	result[2] = m0[2];
+	result[3] = m0[4];
+	result[4] = m0[5];
+	result[5] = m0[6];
+	result[6] = m0[8];
+	result[7] = m0[9];
+	result[8] = m0[10];
+	result[9] = m0[12];
+	result[10] = m0[13];
+	result[11] = m0[14];
+	return result;
+}
+
+mfloat_t *mat3x4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+{
+	mfloat_t multiplied[MAT3X4_SIZE];
+	multiplied[0] = m0[0] * m1[0] + m0[3] * m1[1] + m0[6] * m1[2];
+	multiplied[1] = m0[1] * m1[0] + m0[4] * m1[1] + m0[7] * m1[2];
+	multiplied[2] = m0[2] * m1[0] + m0[5] * m1[1] + m0[8] * m1[2];
+	multiplied[3] = m0[0] * m1[3] + m0[3] * m1[4] + m0[6] * m1[5];
+	multiplied[4] = m0[1] * m1[3] + m0[4] * m1[4] + m0[7] * m1[5];
+	multiplied[5] = m0[2] * m1[3] + m0[5] * m1[4] + m0[8] * m1[5];
+	multiplied[6] = m0[0] * m1[6] + m0[3] * m1[7] + m0[6] * m1[8];
+	multiplied[7] = m0[1] * m1[6] + m0[4] * m1[7] + m0[7] * m1[8];
+	multiplied[8] = m0[2] * m1[6] + m0[5] * m1[7] + m0[8] * m1[8];
+	multiplied[9] = m0[0] * m1[9] + m0[3] * m1[10] + m0[6] * m1[11] + m0[9];
+	multiplied[10] = m0[1] * m1[9] + m0[4] * m1[10] + m0[7] * m1[11] + m0[10];
+	multiplied[11] = m0[2] * m1[9] + m0[5] * m1[10] + m0[8] * m1[11] + m0[11];
+	result[0] = multiplied[0];
+	result[1] = multiplied[1];
+	result[2] = multiplied[2];
+	result[3] = multiplied[3];
+	result[4] = multiplied[4];
+	result[5] = multiplied[5];
+	result[6] = multiplied[6];
+	result[7] = multiplied[7];
+	result[8] = multiplied[8];
+	result[9] = multiplied[9];
+	result[10] = multiplied[10];
+	result[11] = multiplied[11];
+	return result;
+}
+
+mfloat_t *mat3x4_multiply_n(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count)
+{
+	for (size_t i = 0; i < count * MAT3X4_SIZE; i += MAT3X4_SIZE) {
+		mat3x4_multiply(result + i, m0 + i, m1 + i);
+	}
+	return result;
+}
+
+mfloat_t *mat3x4_inverse(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t inverse[MAT3_SIZE];
+	mfloat_t inverted_determinant;
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[3];
+	mfloat_t m22 = m0[4];
+	mfloat_t m32 = m0[5];
+	mfloat_t m13 = m0[6];
+	mfloat_t m23 = m0[7];
+	mfloat_t m33 = m0[8];
+	mfloat_t m14 = m0[9];
+	mfloat_t m24 = m0[10];
+	mfloat_t m34 = m0[11];
+	inverse[0] = m22 * m33 - m23 * m32;
+	inverse[1] = m23 * m31 - m21 * m33;
+	inverse[2] = m21 * m32 - m22 * m31;
+	inverse[3] = m13 * m32 - m12 * m33;
+	inverse[4] = m11 * m33 - m13 * m31;
+	inverse[5] = m12 * m31 - m11 * m32;
+	inverse[6] = m12 * m23 - m13 * m22;
+	inverse[7] = m13 * m21 - m11 * m23;
+	inverse[8] = m11 * m22 - m12 * m21;
+	inverted_determinant = MFLOAT_C(1.0) / (m11 * inverse[0] + m12 * inverse[1] + m13 * inverse[2]);
+	result[0] = inverse[0] * inverted_determinant;
+	result[1] = inverse[1] * inverted_determinant;
+	result[2] = inverse[2] * inverted_determinant;
+	result[3] = inverse[3] * inverted_determinant;
+	result[4] = inverse[4] * inverted_determinant;
+	result[5] = inverse[5] * inverted_determinant;
+	result[6] = inverse[6] * inverted_determinant;
+	result[7] = inverse[7] * inverted_determinant;
+	result[8] = inverse[8] * inverted_determinant;
+	result[9] = -(result[0] * m14 + result[3] * m24 + result[6] * m34);
+	result[10] = -(result[1] * m14 + result[4] * m24 + result[7] * m34);
+	result[11] = -(result[2] * m14 + result[5] * m24 + result[8] * m34);
+	return result;
+}
+
+mfloat_t *mat3x4_inverse_n(mfloat_t *result, mfloat_t *m0, size_t count)
+{
+	for (size_t i = 0; i < count * MAT3X4_SIZE; i += MAT3X4_SIZE) {
+		mat3x4_inverse(result + i, m0 + i);
+	}
+	return result;
+}
+
+/* Writes the rotation and scaling block, columns are `stride` apart */
+static void trs_rotation_scaling(mfloat_t *result, size_t stride, mfloat_t *q0, mfloat_t *v0)
+{
+	mfloat_t xx = q0[0] * q0[0];
+	mfloat_t yy = q0[1] * q0[1];
+	mfloat_t zz = q0[2] * q0[2];
+	mfloat_t xy = q0[0] * q0[1];
+	mfloat_t zw = q0[2] * q0[3];
+	mfloat_t xz = q0[0] * q0[2];
+	mfloat_t yw = q0[1] * q0[3];
+	mfloat_t yz = q0[1] * q0[2];
+	mfloat_t xw = q0[0] * q0[3];
+	mfloat_t *c0 = result;
+	mfloat_t *c1 = result + stride;
+	mfloat_t *c2 = result + stride * 2;
+	c0[0] = (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (yy + zz)) * v0[0];
+	c0[1] = MFLOAT_C(2.0) * (xy + zw) * v0[0];
+	c0[2] = MFLOAT_C(2.0) * (xz - yw) * v0[0];
+	c1[0] = MFLOAT_C(2.0) * (xy - zw) * v0[1];
+	c1[1] = (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx + zz)) * v0[1];
+	c1[2] = MFLOAT_C(2.0) * (yz + xw) * v0[1];
+	c2[0] = MFLOAT_C(2.0) * (xz + yw) * v0[2];
+	c2[1] = MFLOAT_C(2.0) * (yz - xw) * v0[2];
+	c2[2] = (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx + yy)) * v0[2];
+}
+
+mfloat_t *trs(mfloat_t *result, mfloat_t *v0, mfloat_t *q0, mfloat_t *v1)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	result[2] = v0[2];
+	result[3] = q0[0];
+	result[4] = q0[1];
+	result[5] = q0[2];
+	result[6] = q0[3];
+	result[7] = v1[0];
+	result[8] = v1[1];
+	result[9] = v1[2];
+	return result;
+}
+
+mfloat_t *trs_identity(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(0.0);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(0.0);
+	result[6] = MFLOAT_C(1.0);
+	result[7] = MFLOAT_C(1.0);
+	result[8] = MFLOAT_C(1.0);
+	result[9] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *trs_assign(mfloat_t *result, mfloat_t *t0)
+{
+	result[0] = t0[0];
+	result[1] = t0[1];
+	result[2] = t0[2];
+	result[3] = t0[3];
+	result[4] = t0[4];
+	result[5] = t0[5];
+	result[6] = t0[6];
+	result[7] = t0[7];
+	result[8] = t0[8];
+	result[9] = t0[9];
+	return result;
+}
+
+/* The scale of the result is exact only when the scale of `t0` is uniform
+or the rotation of `t1` is the identity */
+mfloat_t *trs_multiply(mfloat_t *result, mfloat_t *t0, mfloat_t *t1)
+{
+	mfloat_t multiplied[TRS_SIZE];
+	mfloat_t scaled[VEC3_SIZE];
+	scaled[0] = t0[7] * t1[0];
+	scaled[1] = t0[8] * t1[1];
+	scaled[2] = t0[9] * t1[2];
+	vec3_rotate_quat(multiplied, scaled, t0 + 3);
+	multiplied[0] = multiplied[0] + t0[0];
+	multiplied[1] = multiplied[1] + t0[1];
+	multiplied[2] = multiplied[2] + t0[2];
+	quat_multiply(multiplied + 3, t0 + 3, t1 + 3);
+	multiplied[7] = t0[7] * t1[7];
+	multiplied[8] = t0[8] * t1[8];
+	multiplied[9] = t0[9] * t1[9];
+	return trs_assign(result, multiplied);
+}
+
+/* The result is exact only when the scale is uniform */
+mfloat_t *trs_inverse(mfloat_t *result, mfloat_t *t0)
+{
+	mfloat_t inverse[TRS_SIZE];
+	inverse[3] = -t0[3];
+	inverse[4] = -t0[4];
+	inverse[5] = -t0[5];
+	inverse[6] = t0[6];
+	inverse[7] = MFLOAT_C(1.0) / t0[7];
+	inverse[8] = MFLOAT_C(1.0) / t0[8];
+	inverse[9] = MFLOAT_C(1.0) / t0[9];
+	vec3_rotate_quat(inverse, t0, inverse + 3);
+	inverse[0] = -inverse[0] * inverse[7];
+	inverse[1] = -inverse[1] * inverse[8];
+	inverse[2] = -inverse[2] * inverse[9];
+	return trs_assign(result, inverse);
+}
+
+mfloat_t *trs_lerp(mfloat_t *result, mfloat_t *t0, mfloat_t *t1, mfloat_t f)
+{
+	mfloat_t d = t0[3] * t1[3] + t0[4] * t1[4] + t0[5] * t1[5] + t0[6] * t1[6];
+	mfloat_t f1 = d < MFLOAT_C(0.0) ? -f : f;
+	mfloat_t f0 = MFLOAT_C(1.0) - f;
+	mfloat_t qx = t0[3] * f0 + t1[3] * f1;
+	mfloat_t qy = t0[4] * f0 + t1[4] * f1;
+	mfloat_t qz = t0[5] * f0 + t1[5] * f1;
+	mfloat_t qw = t0[6] * f0 + t1[6] * f1;
+	mfloat_t l = MFLOAT_C(1.0) / MSQRT(qx * qx + qy * qy + qz * qz + qw * qw);
+	result[0] = t0[0] + (t1[0] - t0[0]) * f;
+	result[1] = t0[1] + (t1[1] - t0[1]) * f;
+	result[2] = t0[2] + (t1[2] - t0[2]) * f;
+	result[3] = qx * l;
+	result[4] = qy * l;
+	result[5] = qz * l;
+	result[6] = qw * l;
+	result[7] = t0[7] + (t1[7] - t0[7]) * f;
+	result[8] = t0[8] + (t1[8] - t0[8]) * f;
+	result[9] = t0[9] + (t1[9] - t0[9]) * f;
+	return result;
+}
+
+mfloat_t *trs_lerp_n(mfloat_t *result, mfloat_t *t0, mfloat_t *t1, mfloat_t f, size_t count)
+{
+	for (size_t i = 0; i < count * TRS_SIZE; i += TRS_SIZE) {
+		trs_lerp(result + i, t0 + i, t1 + i, f);
+	}
+	return result;
+}
+
+mfloat_t *trs_to_mat4(mfloat_t *result, mfloat_t *t0)
+{
+	mfloat_t tx = t0[0];
+	mfloat_t ty = t0[1];
+	mfloat_t tz = t0[2];
+	trs_rotation_scaling(result, 4, t0 + 3, t0 + 7);
+	result[3] = MFLOAT_C(0.0);
+	result[7] = MFLOAT_C(0.0);
+	result[11] = MFLOAT_C(0.0);
+	result[12] = tx;
+	result[13] = ty;
+	result[14] = tz;
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+mfloat_t *trs_to_mat4_n(mfloat_t *result, mfloat_t *t0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		trs_to_mat4(result + i * MAT4_SIZE, t0 + i * TRS_SIZE);
+	}
+	return result;
+}
+
+mfloat_t *trs_to_mat3x4(mfloat_t *result, mfloat_t *t0)
+{
+	mfloat_t tx = t0[0];
+	mfloat_t ty = t0[1];
+	mfloat_t tz = t0[2];
+	trs_rotation_scaling(result, 3, t0 + 3, t0 + 7);
+	result[9] = tx;
+	result[10] = ty;
+	result[11] = tz;
+	return result;
+}
+
+mfloat_t *trs_to_mat3x4_n(mfloat_t *result, mfloat_t *t0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		trs_to_mat3x4(result + i * MAT3X4_SIZE, t0 + i * TRS_SIZE);
+	}
+	return result;
+}
+
+bool hierarchy_build_levels(struct hierarchy *hierarchy)
+{
+	size_t *parent = hierarchy->parent;
+	size_t count = hierarchy->count;
+	size_t level_first = 0;
+	size_t next_first;
+	size_t i = 0;
+	hierarchy->level_count = 0;
+	hierarchy->levels[0] = 0;
+	while (i < count && parent[i] == HIERARCHY_NO_PARENT) {
+		i++;
+	}
+	while (i > level_first) {
+		hierarchy->level_count++;
+		hierarchy->levels[hierarchy->level_count] = i;
+		/* The next level holds the nodes whose parent is in the current one */
+		next_first = i;
+		while (i < count && parent[i] >= level_first && parent[i] < next_first) {
+			i++;
+		}
+		level_first = next_first;
+	}
+	for (size_t j = 0; j < count; j++) {
+		hierarchy->dirty[j] = true;
+	}
+	return i == count;
+}
+
+void hierarchy_set_dirty(struct hierarchy *hierarchy, size_t index)
+{
+	hierarchy->dirty[index] = true;
+}
+
+void hierarchy_update_range(struct hierarchy *hierarchy, size_t first, size_t last)
+{
+	size_t *parent = hierarchy->parent;
+	bool *dirty = hierarchy->dirty;
+	for (size_t i = first; i < last; i++) {
+		size_t p = parent[i];
+		mfloat_t *q = hierarchy->rotation + i * QUAT_SIZE;
+		mfloat_t *s = hierarchy->scale + i * VEC3_SIZE;
+		mfloat_t *t = hierarchy->position + i * VEC3_SIZE;
+		mfloat_t *world = hierarchy->world + i * MAT4_SIZE;
+		mfloat_t local[MAT4_SIZE];
+		if (p != HIERARCHY_NO_PARENT && dirty[p]) {
+			dirty[i] = true;
+		}
+		if (!dirty[i]) {
+			continue;
+		}
+		trs_rotation_scaling(local, 4, q, s);
+		local[3] = MFLOAT_C(0.0);
+		local[7] = MFLOAT_C(0.0);
+		local[11] = MFLOAT_C(0.0);
+		local[12] = t[0];
+		local[13] = t[1];
+		local[14] = t[2];
+		local[15] = MFLOAT_C(1.0);
+		if (p == HIERARCHY_NO_PARENT) {
+			mat4_assign(world, local);
+		} else {
+			mat4_multiply(world, hierarchy->world + p * MAT4_SIZE, local);
+		}
+	}
+}
+
+void hierarchy_clear_dirty(struct hierarchy *hierarchy)
+{
+	for (size_t i = 0; i < hierarchy->count; i++) {
+		hierarchy->dirty[i] = false;
+	}
+}
+
+void hierarchy_update(struct hierarchy *hierarchy)
+{
+	for (size_t level = 0; level < hierarchy->level_count; level++) {
+		hierarchy_update_range(hierarchy, hierarchy->levels[level], hierarchy->levels[level + 1]);
+	}
+	hierarchy_clear_dirty(hierarchy);
+}
+
+static void transform_builder_flush(struct transform_builder *builder)
+{
+	mfloat_t *q = builder->rotation;
+	mfloat_t *s = builder->scaling;
+	mfloat_t pending[MAT3X4_SIZE];
+	if (q[0] == MFLOAT_C(0.0) && q[1] == MFLOAT_C(0.0) && q[2] == MFLOAT_C(0.0)
+		&& s[0] == MFLOAT_C(1.0) && s[1] == MFLOAT_C(1.0) && s[2] == MFLOAT_C(1.0)) {
+		return;
+	}
+	trs_rotation_scaling(pending, 3, q, s);
+	pending[9] = MFLOAT_C(0.0);
+	pending[10] = MFLOAT_C(0.0);
+	pending[11] = MFLOAT_C(0.0);
+	mat3x4_multiply(builder->matrix, builder->matrix, pending);
+	quat_null(q);
+	s[0] = MFLOAT_C(1.0);
+	s[1] = MFLOAT_C(1.0);
+	s[2] = MFLOAT_C(1.0);
+}
+
+struct transform_builder *transform_builder_begin(struct transform_builder *builder)
+{
+	mat3x4_identity(builder->matrix);
+	quat_null(builder->rotation);
+	builder->scaling[0] = MFLOAT_C(1.0);
+	builder->scaling[1] = MFLOAT_C(1.0);
+	builder->scaling[2] = MFLOAT_C(1.0);
+	return builder;
+}
+
+struct transform_builder *transform_builder_translate(struct transform_builder *builder, mfloat_t *v0)
+{
+	mfloat_t *m = builder->matrix;
+	mfloat_t *s = builder->scaling;
+	mfloat_t t[VEC3_SIZE];
+	/* The translation is moved in front of the pending rotation and scaling */
+	t[0] = v0[0] * s[0];
+	t[1] = v0[1] * s[1];
+	t[2] = v0[2] * s[2];
+	vec3_rotate_quat(t, t, builder->rotation);
+	m[9] = m[9] + m[0] * t[0] + m[3] * t[1] + m[6] * t[2];
+	m[10] = m[10] + m[1] * t[0] + m[4] * t[1] + m[7] * t[2];
+	m[11] = m[11] + m[2] * t[0] + m[5] * t[1] + m[8] * t[2];
+	return builder;
+}
+
+struct transform_builder *transform_builder_rotate(struct transform_builder *builder, mfloat_t *q0)
+{
+	mfloat_t *s = builder->scaling;
+	/* A uniform scaling commutes with the rotation */
+	if (s[0] != s[1] || s[0] != s[2]) {
+		transform_builder_flush(builder);
+	}
+	quat_multiply(builder->rotation, builder->rotation, q0);
+	return builder;
+}
+
+struct transform_builder *transform_builder_rotate_axis(struct transform_builder *builder, mfloat_t *v0, mfloat_t angle)
+{
+	mfloat_t q[QUAT_SIZE];
+	quat_from_axis_angle(q, v0, angle);
+	return transform_builder_rotate(builder, q);
+}
+
+struct transform_builder *transform_builder_scale(struct transform_builder *builder, mfloat_t *v0)
+{
+	builder->scaling[0] = builder->scaling[0] * v0[0];
+	builder->scaling[1] = builder->scaling[1] * v0[1];
+	builder->scaling[2] = builder->scaling[2] * v0[2];
+	return builder;
+}
+
+/* Shears the coordinates as in `x' = x + xy * y + xz * z` */
+struct transform_builder *transform_builder_shear(struct transform_builder *builder, mfloat_t xy, mfloat_t xz, mfloat_t yx, mfloat_t yz, mfloat_t zx, mfloat_t zy)
+{
+	mfloat_t *m = builder->matrix;
+	mfloat_t c0[VEC3_SIZE];
+	mfloat_t c1[VEC3_SIZE];
+	mfloat_t c2[VEC3_SIZE];
+	transform_builder_flush(builder);
+	c0[0] = m[0] + m[3] * yx + m[6] * zx;
+	c0[1] = m[1] + m[4] * yx + m[7] * zx;
+	c0[2] = m[2] + m[5] * yx + m[8] * zx;
+	c1[0] = m[0] * xy + m[3] + m[6] * zy;
+	c1[1] = m[1] * xy + m[4] + m[7] * zy;
+	c1[2] = m[2] * xy + m[5] + m[8] * zy;
+	c2[0] = m[0] * xz + m[3] * yz + m[6];
+	c2[1] = m[1] * xz + m[4] * yz + m[7];
+	c2[2] = m[2] * xz + m[5] * yz + m[8];
+	vec3_assign(m, c0);
+	vec3_assign(m + 3, c1);
+	vec3_assign(m + 6, c2);
+	return builder;
+}
+
+struct transform_builder *transform_builder_multiply(struct transform_builder *builder, mfloat_t *m0)
+{
+	transform_builder_flush(builder);
+	mat3x4_multiply(builder->matrix, builder->matrix, m0);
+	return builder;
+}
+
+mfloat_t *transform_builder_finish_mat4(mfloat_t *result, struct transform_builder *builder)
+{
+	transform_builder_flush(builder);
+	return mat4_assign_mat3x4(result, builder->matrix);
+}
+
+mfloat_t *transform_builder_finish_mat3x4(mfloat_t *result, struct transform_builder *builder)
+{
+	transform_builder_flush(builder);
+	return mat3x4_assign(result, builder->matrix);
+}
+
+/* Steps between the exact slerps of the stepper, which keep the rounding
+errors of the multiplications from adding up */
+#define SLERP_STEPPER_RESYNC_INTERVAL 16
+
+/* Prepares the samples of the slerp from the unit quaternions `q0` to `q1`
+at the factors 0, 1 / steps, 2 / steps, ... taking the shortest path */
+struct slerp_stepper *slerp_stepper_begin(struct slerp_stepper *stepper, mfloat_t *q0, mfloat_t *q1, size_t steps)
+{
+	mfloat_t relative[QUAT_SIZE];
+	mfloat_t half_angle;
+	mfloat_t sin_half_angle;
+	mfloat_t f;
+	quat_multiply(relative, quat_conjugate(relative, q0), q1);
+	if (relative[3] < MFLOAT_C(0.0)) {
+		quat_negative(relative, relative);
+	}
+	half_angle = MACOS(MFMIN(relative[3], MFLOAT_C(1.0)));
+	sin_half_angle = MSIN(half_angle);
+	steps = steps > 0 ? steps : 1;
+	f = MFLOAT_C(1.0) / (mfloat_t)steps;
+	if (sin_half_angle > MFLT_EPSILON) {
+		f = MSIN(half_angle * f) / sin_half_angle;
+	}
+	stepper->delta[0] = relative[0] * f;
+	stepper->delta[1] = relative[1] * f;
+	stepper->delta[2] = relative[2] * f;
+	stepper->delta[3] = MCOS(half_angle / (mfloat_t)steps);
+	quat_assign(stepper->current, q0);
+	quat_assign(stepper->q0, q0);
+	quat_assign(stepper->q1, q1);
+	stepper->step = 0;
+	stepper->steps = steps;
+	return stepper;
+}
+
+/* Writes the current sample and advances to the next one */
+mfloat_t *slerp_stepper_next(mfloat_t *result, struct slerp_stepper *stepper)
+{
+	quat_assign(result, stepper->current);
+	quat_multiply(stepper->current, stepper->current, stepper->delta);
+	stepper->step++;
+	if (stepper->step % SLERP_STEPPER_RESYNC_INTERVAL == 0) {
+		/* quat_slerp() interpolates linearly for close quaternions */
+		quat_slerp(stepper->current, stepper->q0, stepper->q1, (mfloat_t)stepper->step / (mfloat_t)stepper->steps);
+		quat_normalize(stepper->current, stepper->current);
+	}
+	return result;
+}
+
+/* Writes `count` samples of the slerp from `q0` to `q1` included, evenly
+spaced, with a slerp stepper */
+mfloat_t *quat_slerp_steps_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, size_t count)
+{
+	struct slerp_stepper stepper;
+	slerp_stepper_begin(&stepper, q0, q1, count > 1 ? count - 1 : 1);
+	for (size_t i = 0; i < count; i++) {
+		slerp_stepper_next(result + i * QUAT_SIZE, &stepper);
+	}
+	return result;
+}
+
+/* Each vertex has four bone indices and four weights, the weights of the
+unused bones must be zero. `normals` and `result_normals` can be NULL */
+void dualquat_skin_n(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		mfloat_t *first = palette + indices[i * 4] * DUALQUAT_SIZE;
+		mfloat_t blended[DUALQUAT_SIZE] = {MFLOAT_C(0.0)};
+		mfloat_t translation[VEC3_SIZE];
+		mfloat_t *p = result_positions + i * VEC3_SIZE;
+		mfloat_t l;
+		for (int k = 0; k < 4; k++) {
+			mfloat_t *d = palette + indices[i * 4 + k] * DUALQUAT_SIZE;
+			mfloat_t w = weights[i * 4 + k];
+			/* Keeps all the bones in the hemisphere of the first one */
+			if (first[0] * d[0] + first[1] * d[1] + first[2] * d[2] + first[3] * d[3] < MFLOAT_C(0.0)) {
+				w = -w;
+			}
+			for (int j = 0; j < DUALQUAT_SIZE; j++) {
+				blended[j] = blended[j] + d[j] * w;
+			}
+		}
+		l = MFLOAT_C(1.0) / MSQRT(blended[0] * blended[0] + blended[1] * blended[1] + blended[2] * blended[2] + blended[3] * blended[3]);
+		for (int j = 0; j < DUALQUAT_SIZE; j++) {
+			blended[j] = blended[j] * l;
+		}
+		dualquat_translation(translation, blended);
+		vec3_rotate_quat(p, positions + i * VEC3_SIZE, blended);
+		p[0] = p[0] + translation[0];
+		p[1] = p[1] + translation[1];
+		p[2] = p[2] + translation[2];
+		if (normals != NULL) {
+			vec3_rotate_quat(result_normals + i * VEC3_SIZE, normals + i * VEC3_SIZE, blended);
+		}
+	}
+}
+
+static void mat4_skin_n_scalar(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		mfloat_t blended[MAT4_SIZE] = {MFLOAT_C(0.0)};
+		mfloat_t *p = positions + i * VEC3_SIZE;
+		mfloat_t *r = result_positions + i * VEC3_SIZE;
+		mfloat_t x;
+		mfloat_t y;
+		mfloat_t z;
+		for (int k = 0; k < 4; k++) {
+			mfloat_t *m = palette + indices[i * 4 + k] * MAT4_SIZE;
+			mfloat_t w = weights[i * 4 + k];
+			for (int j = 0; j < MAT4_SIZE; j++) {
+				blended[j] = blended[j] + m[j] * w;
+			}
+		}
+		x = p[0];
+		y = p[1];
+		z = p[2];
+		r[0] = blended[0] * x + blended[4] * y + blended[8] * z + blended[12];
+		r[1] = blended[1] * x + blended[5] * y + blended[9] * z + blended[13];
+		r[2] = blended[2] * x + blended[6] * y + blended[10] * z + blended[14];
+		if (normals != NULL) {
+			p = normals + i * VEC3_SIZE;
+			r = result_normals + i * VEC3_SIZE;
+			x = p[0];
+			y = p[1];
+			z = p[2];
+			r[0] = blended[0] * x + blended[4] * y + blended[8] * z;
+			r[1] = blended[1] * x + blended[5] * y + blended[9] * z;
+			r[2] = blended[2] * x + blended[6] * y + blended[10] * z;
+		}
+	}
+}
+
+static void mat3x4_skin_n_scalar(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		mfloat_t blended[MAT3X4_SIZE] = {MFLOAT_C(0.0)};
+		mfloat_t *p = positions + i * VEC3_SIZE;
+		mfloat_t *r = result_positions + i * VEC3_SIZE;
+		mfloat_t x;
+		mfloat_t y;
+		mfloat_t z;
+		for (int k = 0; k < 4; k++) {
+			mfloat_t *m = palette + indices[i * 4 + k] * MAT3X4_SIZE;
+			mfloat_t w = weights[i * 4 + k];
+			for (int j = 0; j < MAT3X4_SIZE; j++) {
+				blended[j] = blended[j] + m[j] * w;
+			}
+		}
+		x = p[0];
+		y = p[1];
+		z = p[2];
+		r[0] = blended[0] * x + blended[3] * y + blended[6] * z + blended[9];
+		r[1] = blended[1] * x + blended[4] * y + blended[7] * z + blended[10];
+		r[2] = blended[2] * x + blended[5] * y + blended[8] * z + blended[11];
+		if (normals != NULL) {
+			p = normals + i * VEC3_SIZE;
+			r = result_normals + i * VEC3_SIZE;
+			x = p[0];
+			y = p[1];
+			z = p[2];
+			r[0] = blended[0] * x + blended[3] * y + blended[6] * z;
+			r[1] = blended[1] * x + blended[4] * y + blended[7] * z;
+			r[2] = blended[2] * x + blended[5] * y + blended[8] * z;
+		}
+	}
+}
+
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 void vec3_store_sse2(mfloat_t *result, __m128 v)
+{
+	_mm_storel_pi((__m64 *)result, v);
+	_mm_store_ss(result + 2, _mm_movehl_ps(v, v));
+}
+
+/* Transforms a position and a normal by the blended columns */
+static MATHC_TARGET_SSE2 void skin_columns_sse2(mfloat_t *result_position, mfloat_t *result_normal, mfloat_t *position, mfloat_t *normal, __m128 c0, __m128 c1, __m128 c2, __m128 c3)
+{
+	__m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(position[0])), _mm_mul_ps(c1, _mm_set1_ps(position[1])));
+	r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(position[2])), c3));
+	vec3_store_sse2(result_position, r);
+	if (normal != NULL) {
+		r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(normal[0])), _mm_mul_ps(c1, _mm_set1_ps(normal[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(normal[2])));
+		vec3_store_sse2(result_normal, r);
+	}
+}
+
+static MATHC_TARGET_SSE2 void mat4_skin_n_sse2(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		__m128 c0 = _mm_setzero_ps();
+		__m128 c1 = _mm_setzero_ps();
+		__m128 c2 = _mm_setzero_ps();
+		__m128 c3 = _mm_setzero_ps();
+		for (int k = 0; k < 4; k++) {
+			mfloat_t *m = palette + indices[i * 4 + k] * MAT4_SIZE;
+			__m128 w = _mm_set1_ps(weights[i * 4 + k]);
+			c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(m), w));
+			c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(m + 4), w));
+			c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(m + 8), w));
+			c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(m + 12), w));
+		}
+		skin_columns_sse2(result_positions + i * VEC3_SIZE, normals != NULL ? result_normals + i * VEC3_SIZE : NULL,
+			positions + i * VEC3_SIZE, normals != NULL ? normals + i * VEC3_SIZE : NULL, c0, c1, c2, c3);
+	}
+}
+
+static MATHC_TARGET_SSE2 void mat3x4_skin_n_sse2(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		__m128 c0 = _mm_setzero_ps();
+		__m128 c1 = _mm_setzero_ps();
+		__m128 c2 = _mm_setzero_ps();
+		__m128 c3 = _mm_setzero_ps();
+		for (int k = 0; k < 4; k++) {
+			mfloat_t *m = palette + indices[i * 4 + k] * MAT3X4_SIZE;
+			__m128 w = _mm_set1_ps(weights[i * 4 + k]);
+			/* The fourth lane is ignored, the last column is loaded from the
+			element before it so the palette isn't read past its end */
+			__m128 t = _mm_loadu_ps(m + 8);
+			c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(m), w));
+			c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(m + 3), w));
+			c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(m + 6), w));
+			c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 2, 1)), w));
+		}
+		skin_columns_sse2(result_positions + i * VEC3_SIZE, normals != NULL ? result_normals + i * VEC3_SIZE : NULL,
+			positions + i * VEC3_SIZE, normals != NULL ? normals + i * VEC3_SIZE : NULL, c0, c1, c2, c3);
+	}
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 void mat4_skin_n_avx2(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+	/* The blended matrix is held as two columns per register */
+	for (size_t i = 0; i < count; i++) {
+		__m256 c01 = _mm256_setzero_ps();
+		__m256 c23 = _mm256_setzero_ps();
+		mfloat_t *p = positions + i * VEC3_SIZE;
+		__m256 r;
+		__m128 s;
+		for (int k = 0; k < 4; k++) {
+			mfloat_t *m = palette + indices[i * 4 + k] * MAT4_SIZE;
+			__m256 w = _mm256_set1_ps(weights[i * 4 + k]);
+			c01 = _mm256_fmadd_ps(_mm256_loadu_ps(m), w, c01);
+			c23 = _mm256_fmadd_ps(_mm256_loadu_ps(m + 8), w, c23);
+		}
+		r = _mm256_mul_ps(c01, _mm256_set_m128(_mm_set1_ps(p[1]), _mm_set1_ps(p[0])));
+		r = _mm256_fmadd_ps(c23, _mm256_set_m128(_mm_set1_ps(MFLOAT_C(1.0)), _mm_set1_ps(p[2])), r);
+		s = _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+		vec3_store_sse2(result_positions + i * VEC3_SIZE, s);
+		if (normals != NULL) {
+			p = normals + i * VEC3_SIZE;
+			r = _mm256_mul_ps(c01, _mm256_set_m128(_mm_set1_ps(p[1]), _mm_set1_ps(p[0])));
+			r = _mm256_fmadd_ps(c23, _mm256_set_m128(_mm_setzero_ps(), _mm_set1_ps(p[2])), r);
+			s = _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+			vec3_store_sse2(result_normals + i * VEC3_SIZE, s);
+		}
+	}
+}
+#endif
+
+/* Each vertex has four bone indices and four weights, the weights of the
+unused bones must be zero. Normals are transformed by the blended matrix
+without the translation. `normals` and `result_normals` can be NULL */
+void mat4_skin_n(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	mathc_simd_kernels()->mat4_skin_n(result_positions, result_normals, positions, normals, indices, weights, palette, count);
+#else
+	mat4_skin_n_scalar(result_positions, result_normals, positions, normals, indices, weights, palette, count);
+#endif
+}
+
+void mat3x4_skin_n(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	mathc_simd_kernels()->mat3x4_skin_n(result_positions, result_normals, positions, normals, indices, weights, palette, count);
+#else
+	mat3x4_skin_n_scalar(result_positions, result_normals, positions, normals, indices, weights, palette, count);
+#endif
+}
+
+mfloat_t *aabb(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	result[2] = v0[2];
+	result[3] = v1[0];
+	result[4] = v1[1];
+	result[5] = v1[2];
+	return result;
+}
+
+mfloat_t *aabb_assign(mfloat_t *result, mfloat_t *b0)
+{
+	result[0] = b0[0];
+	result[1] = b0[1];
+	result[2] = b0[2];
+	result[3] = b0[3];
+	result[4] = b0[4];
+	result[5] = b0[5];
+	return result;
+}
+
+mfloat_t *aabb_from_points_n(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	mfloat_t min_x = INFINITY;
+	mfloat_t min_y = min_x;
+	mfloat_t min_z = min_x;
+	mfloat_t max_x = -min_x;
+	mfloat_t max_y = -min_x;
+	mfloat_t max_z = -min_x;
+	for (size_t i = 0; i < count * VEC3_SIZE; i += VEC3_SIZE) {
+		min_x = MFMIN(min_x, v0[i]);
+		min_y = MFMIN(min_y, v0[i + 1]);
+		min_z = MFMIN(min_z, v0[i + 2]);
+		max_x = MFMAX(max_x, v0[i]);
+		max_y = MFMAX(max_y, v0[i + 1]);
+		max_z = MFMAX(max_z, v0[i + 2]);
+	}
+	result[0] = min_x;
+	result[1] = min_y;
+	result[2] = min_z;
+	result[3] = max_x;
+	result[4] = max_y;
+	result[5] = max_z;
+	return result;
+}
+
+mfloat_t *aabb_center(mfloat_t *result, mfloat_t *b0)
+{
+	result[0] = (b0[0] + b0[3]) * MFLOAT_C(0.5);
+	result[1] = (b0[1] + b0[4]) * MFLOAT_C(0.5);
+	result[2] = (b0[2] + b0[5]) * MFLOAT_C(0.5);
+	return result;
+}
+
+mfloat_t *aabb_extents(mfloat_t *result, mfloat_t *b0)
+{
+	result[0] = (b0[3] - b0[0]) * MFLOAT_C(0.5);
+	result[1] = (b0[4] - b0[1]) * MFLOAT_C(0.5);
+	result[2] = (b0[5] - b0[2]) * MFLOAT_C(0.5);
+	return result;
+}
+
+mfloat_t *aabb_union(mfloat_t *result, mfloat_t *b0, mfloat_t *b1)
+{
+	result[0] = MFMIN(b0[0], b1[0]);
+	result[1] = MFMIN(b0[1], b1[1]);
+	result[2] = MFMIN(b0[2], b1[2]);
+	result[3] = MFMAX(b0[3], b1[3]);
+	result[4] = MFMAX(b0[4], b1[4]);
+	result[5] = MFMAX(b0[5], b1[5]);
+	return result;
+}
+
+/* The result is empty when the boxes don't intersect */
+mfloat_t *aabb_intersection(mfloat_t *result, mfloat_t *b0, mfloat_t *b1)
+{
+	result[0] = MFMAX(b0[0], b1[0]);
+	result[1] = MFMAX(b0[1], b1[1]);
+	result[2] = MFMAX(b0[2], b1[2]);
+	result[3] = MFMIN(b0[3], b1[3]);
+	result[4] = MFMIN(b0[4], b1[4]);
+	result[5] = MFMIN(b0[5], b1[5]);
+	return result;
+}
+
+bool aabb_is_empty(mfloat_t *b0)
+{
+	return b0[0] > b0[3] || b0[1] > b0[4] || b0[2] > b0[5];
+}
+
+bool aabb_intersects(mfloat_t *b0, mfloat_t *b1)
+{
+	return b0[0] <= b1[3] && b0[3] >= b1[0]
+		&& b0[1] <= b1[4] && b0[4] >= b1[1]
+		&& b0[2] <= b1[5] && b0[5] >= b1[2];
+}
+
+bool aabb_contains(mfloat_t *b0, mfloat_t *b1)
+{
+	return b0[0] <= b1[0] && b0[3] >= b1[3]
+		&& b0[1] <= b1[1] && b0[4] >= b1[4]
+		&& b0[2] <= b1[2] && b0[5] >= b1[5];
+}
+
+bool aabb_contains_point(mfloat_t *b0, mfloat_t *v0)
+{
+	return b0[0] <= v0[0] && b0[3] >= v0[0]
+		&& b0[1] <= v0[1] && b0[4] >= v0[1]
+		&& b0[2] <= v0[2] && b0[5] >= v0[2];
+}
+
+/* Arvo, the center is transformed by the matrix and the extents by the
+absolute value of its 3x3 part */
+mfloat_t *aabb_transform(mfloat_t *result, mfloat_t *b0, mfloat_t *m0)
+{
+	mfloat_t cx = (b0[0] + b0[3]) * MFLOAT_C(0.5);
+	mfloat_t cy = (b0[1] + b0[4]) * MFLOAT_C(0.5);
+	mfloat_t cz = (b0[2] + b0[5]) * MFLOAT_C(0.5);
+	mfloat_t ex = (b0[3] - b0[0]) * MFLOAT_C(0.5);
+	mfloat_t ey = (b0[4] - b0[1]) * MFLOAT_C(0.5);
+	mfloat_t ez = (b0[5] - b0[2]) * MFLOAT_C(0.5);
+	mfloat_t x = m0[0] * cx + m0[4] * cy + m0[8] * cz + m0[12];
+	mfloat_t y = m0[1] * cx + m0[5] * cy + m0[9] * cz + m0[13];
+	mfloat_t z = m0[2] * cx + m0[6] * cy + m0[10] * cz + m0[14];
+	mfloat_t rx = MFABS(m0[0]) * ex + MFABS(m0[4]) * ey + MFABS(m0[8]) * ez;
+	mfloat_t ry = MFABS(m0[1]) * ex + MFABS(m0[5]) * ey + MFABS(m0[9]) * ez;
+	mfloat_t rz = MFABS(m0[2]) * ex + MFABS(m0[6]) * ey + MFABS(m0[10]) * ez;
+	result[0] = x - rx;
+	result[1] = y - ry;
+	result[2] = z - rz;
+	result[3] = x + rx;
+	result[4] = y + ry;
+	result[5] = z + rz;
+	return result;
+}
+
+static mfloat_t *aabb_transform_n_scalar(mfloat_t *result, mfloat_t *b0, mfloat_t *m0, size_t count)
+{
+	for (size_t i = 0; i < count * AABB_SIZE; i += AABB_SIZE) {
+		aabb_transform(result + i, b0 + i, m0);
+	}
+	return result;
+}
+
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 mfloat_t *aabb_transform_n_sse2(mfloat_t *result, mfloat_t *b0, mfloat_t *m0, size_t count)
+{
+	__m128 half = _mm_set1_ps(MFLOAT_C(0.5));
+	__m128 m11 = _mm_set1_ps(m0[0]);
+	__m128 m21 = _mm_set1_ps(m0[1]);
+	__m128 m31 = _mm_set1_ps(m0[2]);
+	__m128 m12 = _mm_set1_ps(m0[4]);
+	__m128 m22 = _mm_set1_ps(m0[5]);
+	__m128 m32 = _mm_set1_ps(m0[6]);
+	__m128 m13 = _mm_set1_ps(m0[8]);
+	__m128 m23 = _mm_set1_ps(m0[9]);
+	__m128 m33 = _mm_set1_ps(m0[10]);
+	__m128 m14 = _mm_set1_ps(m0[12]);
+	__m128 m24 = _mm_set1_ps(m0[13]);
+	__m128 m34 = _mm_set1_ps(m0[14]);
+	__m128 a11 = _mm_set1_ps(MFABS(m0[0]));
+	__m128 a21 = _mm_set1_ps(MFABS(m0[1]));
+	__m128 a31 = _mm_set1_ps(MFABS(m0[2]));
+	__m128 a12 = _mm_set1_ps(MFABS(m0[4]));
+	__m128 a22 = _mm_set1_ps(MFABS(m0[5]));
+	__m128 a32 = _mm_set1_ps(MFABS(m0[6]));
+	__m128 a13 = _mm_set1_ps(MFABS(m0[8]));
+	__m128 a23 = _mm_set1_ps(MFABS(m0[9]));
+	__m128 a33 = _mm_set1_ps(MFABS(m0[10]));
+	size_t i = 0;
+	/* Four boxes per iteration, the six loads are transposed to one
+	register per component of the boxes and back */
+	for (; i + 4 <= count; i += 4) {
+		mfloat_t *b = b0 + i * AABB_SIZE;
+		mfloat_t *r = result + i * AABB_SIZE;
+		__m128 l0 = _mm_loadu_ps(b);
+		__m128 l1 = _mm_loadu_ps(b + 4);
+		__m128 l2 = _mm_loadu_ps(b + 8);
+		__m128 l3 = _mm_loadu_ps(b + 12);
+		__m128 l4 = _mm_loadu_ps(b + 16);
+		__m128 l5 = _mm_loadu_ps(b + 20);
+		/* The first four components of each box, until the transpose */
+		__m128 min_x = l0;
+		__m128 min_y = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(1, 0, 3, 2));
+		__m128 min_z = l3;
+		__m128 max_x = _mm_shuffle_ps(l4, l5, _MM_SHUFFLE(1, 0, 3, 2));
+		__m128 t0 = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(3, 2, 1, 0));
+		__m128 t1 = _mm_shuffle_ps(l4, l5, _MM_SHUFFLE(3, 2, 1, 0));
+		__m128 max_y = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 max_z = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 3, 1));
+		__m128 cx;
+		__m128 cy;
+		__m128 cz;
+		__m128 ex;
+		__m128 ey;
+		__m128 ez;
+		__m128 x;
+		__m128 y;
+		__m128 z;
+		__m128 rx;
+		__m128 ry;
+		__m128 rz;
+		_MM_TRANSPOSE4_PS(min_x, min_y, min_z, max_x);
+		cx = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+		cy = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+		cz = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+		ex = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+		ey = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+		ez = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+		x = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m11, cx), _mm_mul_ps(m12, cy)), _mm_mul_ps(m13, cz)), m14);
+		y = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m21, cx), _mm_mul_ps(m22, cy)), _mm_mul_ps(m23, cz)), m24);
+		z = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m31, cx), _mm_mul_ps(m32, cy)), _mm_mul_ps(m33, cz)), m34);
+		rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a11, ex), _mm_mul_ps(a12, ey)), _mm_mul_ps(a13, ez));
+		ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a21, ex), _mm_mul_ps(a22, ey)), _mm_mul_ps(a23, ez));
+		rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a31, ex), _mm_mul_ps(a32, ey)), _mm_mul_ps(a33, ez));
+		min_x = _mm_sub_ps(x, rx);
+		min_y = _mm_sub_ps(y, ry);
+		min_z = _mm_sub_ps(z, rz);
+		max_x = _mm_add_ps(x, rx);
+		max_y = _mm_add_ps(y, ry);
+		max_z = _mm_add_ps(z, rz);
+		_MM_TRANSPOSE4_PS(min_x, min_y, min_z, max_x);
+		t0 = _mm_unpacklo_ps(max_y, max_z);
+		t1 = _mm_unpackhi_ps(max_y, max_z);
+		_mm_storeu_ps(r, min_x);
+		_mm_storeu_ps(r + 4, _mm_shuffle_ps(t0, min_y, _MM_SHUFFLE(1, 0, 1, 0)));
+		_mm_storeu_ps(r + 8, _mm_shuffle_ps(min_y, t0, _MM_SHUFFLE(3, 2, 3, 2)));
+		_mm_storeu_ps(r + 12, min_z);
+		_mm_storeu_ps(r + 16, _mm_shuffle_ps(t1, max_x, _MM_SHUFFLE(1, 0, 1, 0)));
+		_mm_storeu_ps(r + 20, _mm_shuffle_ps(max_x, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+	}
+	aabb_transform_n_scalar(result + i * AABB_SIZE, b0 + i * AABB_SIZE, m0, count - i);
+	return result;
+}
+#endif
+
+mfloat_t *aabb_transform_n(mfloat_t *result, mfloat_t *b0, mfloat_t *m0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->aabb_transform_n(result, b0, m0, count);
+#else
+	return aabb_transform_n_scalar(result, b0, m0, count);
+#endif
+}
+
+mfloat_t *ray(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	result[2] = v0[2];
+	result[3] = v1[0];
+	result[4] = v1[1];
+	result[5] = v1[2];
+	return result;
+}
+
+mfloat_t *ray_assign(mfloat_t *result, mfloat_t *r0)
+{
+	result[0] = r0[0];
+	result[1] = r0[1];
+	result[2] = r0[2];
+	result[3] = r0[3];
+	result[4] = r0[4];
+	result[5] = r0[5];
+	return result;
+}
+
+mfloat_t *ray_at(mfloat_t *result, mfloat_t *r0, mfloat_t t)
+{
+	result[0] = r0[0] + r0[3] * t;
+	result[1] = r0[1] + r0[4] * t;
+	result[2] = r0[2] + r0[5] * t;
+	return result;
+}
+
+/* Moller and Trumbore, two-sided. `result` receives the distance along
+the ray and the barycentric coordinates of `v1` and `v2`; the distance is
+infinite when the triangle is missed. A degenerate triangle or a ray
+parallel to it makes the barycentric coordinates NaN, which also misses */
+bool ray_intersect_triangle(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+{
+	mfloat_t e1x = v1[0] - v0[0];
+	mfloat_t e1y = v1[1] - v0[1];
+	mfloat_t e1z = v1[2] - v0[2];
+	mfloat_t e2x = v2[0] - v0[0];
+	mfloat_t e2y = v2[1] - v0[1];
+	mfloat_t e2z = v2[2] - v0[2];
+	mfloat_t px = r0[4] * e2z - r0[5] * e2y;
+	mfloat_t py = r0[5] * e2x - r0[3] * e2z;
+	mfloat_t pz = r0[3] * e2y - r0[4] * e2x;
+	mfloat_t inverted_determinant = MFLOAT_C(1.0) / (e1x * px + e1y * py + e1z * pz);
+	mfloat_t sx = r0[0] - v0[0];
+	mfloat_t sy = r0[1] - v0[1];
+	mfloat_t sz = r0[2] - v0[2];
+	mfloat_t qx = sy * e1z - sz * e1y;
+	mfloat_t qy = sz * e1x - sx * e1z;
+	mfloat_t qz = sx * e1y - sy * e1x;
+	mfloat_t u = (sx * px + sy * py + sz * pz) * inverted_determinant;
+	mfloat_t v = (r0[3] * qx + r0[4] * qy + r0[5] * qz) * inverted_determinant;
+	mfloat_t t = (e2x * qx + e2y * qy + e2z * qz) * inverted_determinant;
+	bool hit = u >= MFLOAT_C(0.0) && v >= MFLOAT_C(0.0) && u + v <= MFLOAT_C(1.0) && t > MFLOAT_C(0.0);
+	result[0] = hit ? t : INFINITY;
+	result[1] = u;
+	result[2] = v;
+	return hit;
+}
+
+static size_t ray_closest_hit(mfloat_t *result, size_t count)
+{
+	size_t closest = count;
+	mfloat_t closest_t = INFINITY;
+	for (size_t i = 0; i < count; i++) {
+		if (result[i * VEC3_SIZE] < closest_t) {
+			closest_t = result[i * VEC3_SIZE];
+			closest = i;
+		}
+	}
+	return closest;
+}
+
+static void ray_intersect_triangles_n_scalar(mfloat_t *result, mfloat_t *r0, mfloat_t *t0, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		mfloat_t *t = t0 + i * TRIANGLE_SIZE;
+		ray_intersect_triangle(result + i * VEC3_SIZE, r0, t, t + 3, t + 6);
+	}
+}
+
+static void rays_intersect_triangle_n_scalar(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		ray_intersect_triangle(result + i * VEC3_SIZE, r0 + i * RAY_SIZE, v0, v1, v2);
+	}
+}
+
+#if defined(MATHC_SIMD_SSE2)
+/* One lane per ray and triangle pair, writes the distance and the
+barycentric coordinates as in ray_intersect_triangle() */
+static MATHC_TARGET_SSE2 void ray_intersect_triangle_sse2(__m128 *result, __m128 *r, __m128 *t)
+{
+	__m128 zero = _mm_setzero_ps();
+	__m128 e1x = _mm_sub_ps(t[3], t[0]);
+	__m128 e1y = _mm_sub_ps(t[4], t[1]);
+	__m128 e1z = _mm_sub_ps(t[5], t[2]);
+	__m128 e2x = _mm_sub_ps(t[6], t[0]);
+	__m128 e2y = _mm_sub_ps(t[7], t[1]);
+	__m128 e2z = _mm_sub_ps(t[8], t[2]);
+	__m128 px = _mm_sub_ps(_mm_mul_ps(r[4], e2z), _mm_mul_ps(r[5], e2y));
+	__m128 py = _mm_sub_ps(_mm_mul_ps(r[5], e2x), _mm_mul_ps(r[3], e2z));
+	__m128 pz = _mm_sub_ps(_mm_mul_ps(r[3], e2y), _mm_mul_ps(r[4], e2x));
+	__m128 determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+	__m128 inverted_determinant = _mm_div_ps(_mm_set1_ps(MFLOAT_C(1.0)), determinant);
+	__m128 sx = _mm_sub_ps(r[0], t[0]);
+	__m128 sy = _mm_sub_ps(r[1], t[1]);
+	__m128 sz = _mm_sub_ps(r[2], t[2]);
+	__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+	__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+	__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+	__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inverted_determinant);
+	__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r[3], qx), _mm_mul_ps(r[4], qy)), _mm_mul_ps(r[5], qz)), inverted_determinant);
+	__m128 distance = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverted_determinant);
+	__m128 hit = _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero));
+	hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(MFLOAT_C(1.0))));
+	hit = _mm_and_ps(hit, _mm_cmpgt_ps(distance, zero));
+	result[0] = _mm_or_ps(_mm_and_ps(hit, distance), _mm_andnot_ps(hit, _mm_set1_ps(INFINITY)));
+	result[1] = u;
+	result[2] = v;
+}
+
+/* Writes four lanes of distance and barycentric coordinates as vec3 */
+static MATHC_TARGET_SSE2 void ray_store_hits_sse2(mfloat_t *result, __m128 t, __m128 u, __m128 v)
+{
+	__m128 w = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(t, u, v, w);
+	vec3_store_sse2(result, t);
+	vec3_store_sse2(result + 3, u);
+	vec3_store_sse2(result + 6, v);
+	vec3_store_sse2(result + 9, w);
+}
+
+static MATHC_TARGET_SSE2 void ray_intersect_triangles_n_sse2(mfloat_t *result, mfloat_t *r0, mfloat_t *t0, size_t count)
+{
+	/* One ray against four triangles */
+	__m128 r[RAY_SIZE];
+	__m128 t[TRIANGLE_SIZE];
+	__m128 hits[3];
+	size_t i = 0;
+	for (int j = 0; j < RAY_SIZE; j++) {
+		r[j] = _mm_set1_ps(r0[j]);
+	}
+	for (; i + 4 <= count; i += 4) {
+		mfloat_t *p = t0 + i * TRIANGLE_SIZE;
+		for (int j = 0; j < TRIANGLE_SIZE; j++) {
+			t[j] = _mm_set_ps(p[TRIANGLE_SIZE * 3 + j], p[TRIANGLE_SIZE * 2 + j], p[TRIANGLE_SIZE + j], p[j]);
+		}
+		ray_intersect_triangle_sse2(hits, r, t);
+		ray_store_hits_sse2(result + i * VEC3_SIZE, hits[0], hits[1], hits[2]);
+	}
+	ray_intersect_triangles_n_scalar(result + i * VEC3_SIZE, r0, t0 + i * TRIANGLE_SIZE, count - i);
+}
+
+static MATHC_TARGET_SSE2 void rays_intersect_triangle_n_sse2(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count)
+{
+	/* Four rays against one triangle */
+	__m128 r[RAY_SIZE];
+	__m128 t[TRIANGLE_SIZE];
+	__m128 hits[3];
+	size_t i = 0;
+	for (int j = 0; j < 3; j++) {
+		t[j] = _mm_set1_ps(v0[j]);
+		t[3 + j] = _mm_set1_ps(v1[j]);
+		t[6 + j] = _mm_set1_ps(v2[j]);
+	}
+	for (; i + 4 <= count; i += 4) {
+		mfloat_t *p = r0 + i * RAY_SIZE;
+		for (int j = 0; j < RAY_SIZE; j++) {
+			r[j] = _mm_set_ps(p[RAY_SIZE * 3 + j], p[RAY_SIZE * 2 + j], p[RAY_SIZE + j], p[j]);
+		}
+		ray_intersect_triangle_sse2(hits, r, t);
+		ray_store_hits_sse2(result + i * VEC3_SIZE, hits[0], hits[1], hits[2]);
+	}
+	rays_intersect_triangle_n_scalar(result + i * VEC3_SIZE, r0 + i * RAY_SIZE, v0, v1, v2, count - i);
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 void ray_intersect_triangle_avx2(__m256 *result, __m256 *r, __m256 *t)
+{
+	__m256 zero = _mm256_setzero_ps();
+	__m256 e1x = _mm256_sub_ps(t[3], t[0]);
+	__m256 e1y = _mm256_sub_ps(t[4], t[1]);
+	__m256 e1z = _mm256_sub_ps(t[5], t[2]);
+	__m256 e2x = _mm256_sub_ps(t[6], t[0]);
+	__m256 e2y = _mm256_sub_ps(t[7], t[1]);
+	__m256 e2z = _mm256_sub_ps(t[8], t[2]);
+	__m256 px = _mm256_fmsub_ps(r[4], e2z, _mm256_mul_ps(r[5], e2y));
+	__m256 py = _mm256_fmsub_ps(r[5], e2x, _mm256_mul_ps(r[3], e2z));
+	__m256 pz = _mm256_fmsub_ps(r[3], e2y, _mm256_mul_ps(r[4], e2x));
+	__m256 determinant = _mm256_fmadd_ps(e1z, pz, _mm256_fmadd_ps(e1y, py, _mm256_mul_ps(e1x, px)));
+	__m256 inverted_determinant = _mm256_div_ps(_mm256_set1_ps(MFLOAT_C(1.0)), determinant);
+	__m256 sx = _mm256_sub_ps(r[0], t[0]);
+	__m256 sy = _mm256_sub_ps(r[1], t[1]);
+	__m256 sz = _mm256_sub_ps(r[2], t[2]);
+	__m256 qx = _mm256_fmsub_ps(sy, e1z, _mm256_mul_ps(sz, e1y));
+	__m256 qy = _mm256_fmsub_ps(sz, e1x, _mm256_mul_ps(sx, e1z));
+	__m256 qz = _mm256_fmsub_ps(sx, e1y, _mm256_mul_ps(sy, e1x));
+	__m256 u = _mm256_mul_ps(_mm256_fmadd_ps(sz, pz, _mm256_fmadd_ps(sy, py, _mm256_mul_ps(sx, px))), inverted_determinant);
+	__m256 v = _mm256_mul_ps(_mm256_fmadd_ps(r[5], qz, _mm256_fmadd_ps(r[4], qy, _mm256_mul_ps(r[3], qx))), inverted_determinant);
+	__m256 distance = _mm256_mul_ps(_mm256_fmadd_ps(e2z, qz, _mm256_fmadd_ps(e2y, qy, _mm256_mul_ps(e2x, qx))), inverted_determinant);
+	__m256 hit = _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+	hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(MFLOAT_C(1.0)), _CMP_LE_OQ));
+	hit = _mm256_and_ps(hit, _mm256_cmp_ps(distance, zero, _CMP_GT_OQ));
+	result[0] = _mm256_blendv_ps(_mm256_set1_ps(INFINITY), distance, hit);
+	result[1] = u;
+	result[2] = v;
+}
+
+static MATHC_TARGET_AVX2 void ray_store_hits_avx2(mfloat_t *result, __m256 *hits)
+{
+	ray_store_hits_sse2(result, _mm256_castps256_ps128(hits[0]), _mm256_castps256_ps128(hits[1]), _mm256_castps256_ps128(hits[2]));
+	ray_store_hits_sse2(result + 12, _mm256_extractf128_ps(hits[0], 1), _mm256_extractf128_ps(hits[1], 1), _mm256_extractf128_ps(hits[2], 1));
+}
+
+static MATHC_TARGET_AVX2 void ray_intersect_triangles_n_avx2(mfloat_t *result, mfloat_t *r0, mfloat_t *t0, size_t count)
+{
+	/* One ray against eight triangles, gathered from the triangle array */
+	__m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(TRIANGLE_SIZE));
+	__m256 r[RAY_SIZE];
+	__m256 t[TRIANGLE_SIZE];
+	__m256 hits[3];
+	size_t i = 0;
+	for (int j = 0; j < RAY_SIZE; j++) {
+		r[j] = _mm256_set1_ps(r0[j]);
+	}
+	for (; i + 8 <= count; i += 8) {
+		mfloat_t *p = t0 + i * TRIANGLE_SIZE;
+		for (int j = 0; j < TRIANGLE_SIZE; j++) {
+			t[j] = _mm256_i32gather_ps(p + j, offsets, 4);
+		}
+		ray_intersect_triangle_avx2(hits, r, t);
+		ray_store_hits_avx2(result + i * VEC3_SIZE, hits);
+	}
+	ray_intersect_triangles_n_sse2(result + i * VEC3_SIZE, r0, t0 + i * TRIANGLE_SIZE, count - i);
+}
+
+static MATHC_TARGET_AVX2 void rays_intersect_triangle_n_avx2(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count)
+{
+	/* Eight rays against one triangle, gathered from the ray array */
+	__m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(RAY_SIZE));
+	__m256 r[RAY_SIZE];
+	__m256 t[TRIANGLE_SIZE];
+	__m256 hits[3];
+	size_t i = 0;
+	for (int j = 0; j < 3; j++) {
+		t[j] = _mm256_set1_ps(v0[j]);
+		t[3 + j] = _mm256_set1_ps(v1[j]);
+		t[6 + j] = _mm256_set1_ps(v2[j]);
+	}
+	for (; i + 8 <= count; i += 8) {
+		mfloat_t *p = r0 + i * RAY_SIZE;
+		for (int j = 0; j < RAY_SIZE; j++) {
+			r[j] = _mm256_i32gather_ps(p + j, offsets, 4);
+		}
+		ray_intersect_triangle_avx2(hits, r, t);
+		ray_store_hits_avx2(result + i * VEC3_SIZE, hits);
+	}
+	rays_intersect_triangle_n_sse2(result + i * VEC3_SIZE, r0 + i * RAY_SIZE, v0, v1, v2, count - i);
+}
+#endif
+
+/* Tests one ray against `count` triangles of TRIANGLE_SIZE floats and
+writes the distance and barycentric coordinates of each one to `result`.
+Returns the index of the closest hit, or `count` when nothing is hit */
+size_t ray_intersect_triangles_n(mfloat_t *result, mfloat_t *r0, mfloat_t *t0, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	mathc_simd_kernels()->ray_intersect_triangles_n(result, r0, t0, count);
+#else
+	ray_intersect_triangles_n_scalar(result, r0, t0, count);
+#endif
+	return ray_closest_hit(result, count);
+}
+
+/* Tests `count` rays against one triangle, as ray_intersect_triangles_n() */
+size_t rays_intersect_triangle_n(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count)
+{
+#if defined(MATHC_SIMD_SSE2)
+	mathc_simd_kernels()->rays_intersect_triangle_n(result, r0, v0, v1, v2, count);
+#else
+	rays_intersect_triangle_n_scalar(result, r0, v0, v1, v2, count);
+#endif
+	return ray_closest_hit(result, count);
+}
+
+/* Prepares a ray for the slab tests: keeps the origin and replaces the
+direction by its reciprocal. Zero components become infinities, so the
+distances to the planes of a slab parallel to the ray are infinite, or
+NaN when the origin is on the plane */
+mfloat_t *ray_inverse_direction(mfloat_t *result, mfloat_t *r0)
+{
+	result[0] = r0[0];
+	result[1] = r0[1];
+	result[2] = r0[2];
+	result[3] = MFLOAT_C(1.0) / r0[3];
+	result[4] = MFLOAT_C(1.0) / r0[4];
+	result[5] = MFLOAT_C(1.0) / r0[5];
+	return result;
+}
+
+/* Slab test of a ray prepared by ray_inverse_direction(). The near and far
+planes of each slab are picked from the direction sign, so empty boxes
+never intersect. The minimum and maximum ignore NaN, so a ray parallel to
+a slab and on one of its planes is inside it, whatever the face and the
+sign of the zero. `result` receives the entry distance, clamped to zero
+when the origin is inside, or infinity on a miss */
+bool ray_intersect_aabb(mfloat_t *result, mfloat_t *r0, mfloat_t *b0, mfloat_t t_max)
+{
+	mfloat_t t_near = MFLOAT_C(0.0);
+	mfloat_t t_far = MFMIN(t_max, MFLT_MAX);
+	bool hit;
+	for (int i = 0; i < 3; i++) {
+		bool negative = r0[3 + i] < MFLOAT_C(0.0);
+		mfloat_t t0 = (b0[negative ? 3 + i : i] - r0[i]) * r0[3 + i];
+		mfloat_t t1 = (b0[negative ? i : 3 + i] - r0[i]) * r0[3 + i];
+		t_near = MFMAX(t_near, t0);
+		t_far = MFMIN(t_far, t1);
+	}
+	hit = t_near <= t_far;
+	result[0] = hit ? t_near : INFINITY;
+	return hit;
+}
+
+/* Boxes in `b0` are SoA: the component `k` of the box `i`, in the order
+of AABB_SIZE, is at `b0[k * stride + i]` */
+static size_t ray_intersect_aabbs_range(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t first, size_t count)
+{
+	size_t near_plane[3];
+	size_t far_plane[3];
+	size_t hits = 0;
+	for (int j = 0; j < 3; j++) {
+		bool negative = r0[3 + j] < MFLOAT_C(0.0);
+		near_plane[j] = (negative ? 3 + j : j) * stride;
+		far_plane[j] = (negative ? j : 3 + j) * stride;
+	}
+	for (size_t i = first; i < count; i++) {
+		mfloat_t t_near = MFLOAT_C(0.0);
+		mfloat_t t_far = MFMIN(t_max, MFLT_MAX);
+		bool hit;
+		for (int j = 0; j < 3; j++) {
+			t_near = MFMAX(t_near, (b0[near_plane[j] + i] - r0[j]) * r0[3 + j]);
+			t_far = MFMIN(t_far, (b0[far_plane[j] + i] - r0[j]) * r0[3 + j]);
+		}
+		hit = t_near <= t_far;
+		result[i] = hit ? t_near : INFINITY;
+		mask[i / 32] |= (uint32_t)hit << (i % 32);
+		hits = hits + hit;
+	}
+	return hits;
+}
+
+static size_t ray_intersect_aabbs_n_scalar(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count)
+{
+	return ray_intersect_aabbs_range(result, mask, r0, b0, stride, t_max, 0, count);
+}
+
+#if defined(MATHC_SIMD_SSE2)
+static MATHC_TARGET_SSE2 size_t ray_intersect_aabbs_range_sse2(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t first, size_t count)
+{
+	mfloat_t *near_plane[3];
+	mfloat_t *far_plane[3];
+	__m128 origin[3];
+	__m128 inverse[3];
+	__m128 infinity = _mm_set1_ps(INFINITY);
+	__m128i hits = _mm_setzero_si128();
+	size_t i = first;
+	for (int j = 0; j < 3; j++) {
+		bool negative = r0[3 + j] < MFLOAT_C(0.0);
+		near_plane[j] = b0 + (negative ? 3 + j : j) * stride;
+		far_plane[j] = b0 + (negative ? j : 3 + j) * stride;
+		origin[j] = _mm_set1_ps(r0[j]);
+		inverse[j] = _mm_set1_ps(r0[3 + j]);
+	}
+	for (; i + 4 <= count; i += 4) {
+		__m128 t_near = _mm_setzero_ps();
+		__m128 t_far = _mm_set1_ps(MFMIN(t_max, MFLT_MAX));
+		__m128 hit;
+		/* minps and maxps return the second operand when one is NaN */
+		for (int j = 0; j < 3; j++) {
+			t_near = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(near_plane[j] + i), origin[j]), inverse[j]), t_near);
+			t_far = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(far_plane[j] + i), origin[j]), inverse[j]), t_far);
+		}
+		hit = _mm_cmple_ps(t_near, t_far);
+		_mm_storeu_ps(result + i, _mm_or_ps(_mm_and_ps(hit, t_near), _mm_andnot_ps(hit, infinity)));
+		mask[i / 32] |= (uint32_t)_mm_movemask_ps(hit) << (i % 32);
+		hits = _mm_sub_epi32(hits, _mm_castps_si128(hit));
+	}
+	hits = _mm_add_epi32(hits, _mm_shuffle_epi32(hits, _MM_SHUFFLE(1, 0, 3, 2)));
+	hits = _mm_add_epi32(hits, _mm_shuffle_epi32(hits, _MM_SHUFFLE(2, 3, 0, 1)));
+	return (size_t)_mm_cvtsi128_si32(hits) + ray_intersect_aabbs_range(result, mask, r0, b0, stride, t_max, i, count);
+}
+
+static MATHC_TARGET_SSE2 size_t ray_intersect_aabbs_n_sse2(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count)
+{
+	return ray_intersect_aabbs_range_sse2(result, mask, r0, b0, stride, t_max, 0, count);
+}
+#endif
+
+#if defined(MATHC_SIMD_AVX2)
+static MATHC_TARGET_AVX2 size_t ray_intersect_aabbs_n_avx2(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count)
+{
+	mfloat_t *near_plane[3];
+	mfloat_t *far_plane[3];
+	__m256 origin[3];
+	__m256 inverse[3];
+	__m256 infinity = _mm256_set1_ps(INFINITY);
+	__m256i hits = _mm256_setzero_si256();
+	__m128i sum;
+	size_t i = 0;
+	for (int j = 0; j < 3; j++) {
+		bool negative = r0[3 + j] < MFLOAT_C(0.0);
+		near_plane[j] = b0 + (negative ? 3 + j : j) * stride;
+		far_plane[j] = b0 + (negative ? j : 3 + j) * stride;
+		origin[j] = _mm256_set1_ps(r0[j]);
+		inverse[j] = _mm256_set1_ps(r0[3 + j]);
+	}
+	for (; i + 8 <= count; i += 8) {
+		__m256 t_near = _mm256_setzero_ps();
+		__m256 t_far = _mm256_set1_ps(MFMIN(t_max, MFLT_MAX));
+		__m256 hit;
+		for (int j = 0; j < 3; j++) {
+			t_near = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(near_plane[j] + i), origin[j]), inverse[j]), t_near);
+			t_far = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(far_plane[j] + i), origin[j]), inverse[j]), t_far);
+		}
+		hit = _mm256_cmp_ps(t_near, t_far, _CMP_LE_OQ);
+		_mm256_storeu_ps(result + i, _mm256_blendv_ps(infinity, t_near, hit));
+		mask[i / 32] |= (uint32_t)_mm256_movemask_ps(hit) << (i % 32);
+		hits = _mm256_sub_epi32(hits, _mm256_castps_si256(hit));
+	}
+	sum = _mm_add_epi32(_mm256_castsi256_si128(hits), _mm256_extracti128_si256(hits, 1));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return (size_t)_mm_cvtsi128_si32(sum) + ray_intersect_aabbs_range_sse2(result, mask, r0, b0, stride, t_max, i, count);
+}
+#endif
+
+/* Tests a ray prepared by ray_inverse_direction() against `count` SoA
+boxes (see ray_intersect_aabbs_range()) up to the distance `t_max`. Writes
+the entry distance of each box to `result` and sets the bit `i % 32` of
+`mask[i / 32]` for each box hit. Returns the number of boxes hit */
+size_t ray_intersect_aabbs_n(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count)
+{
+	for (size_t i = 0; i < (count + 31) / 32; i++) {
+		mask[i] = 0;
+	}
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->ray_intersect_aabbs_n(result, mask, r0, b0, stride, t_max, count);
+#else
+	return ray_intersect_aabbs_n_scalar(result, mask, r0, b0, stride, t_max, count);
+#endif
+}
+
+static mfloat_t aabb_half_area(mfloat_t *b0)
+{
+	mfloat_t x = b0[3] - b0[0];
+	mfloat_t y = b0[4] - b0[1];
+	mfloat_t z = b0[5] - b0[2];
+	return x * y + y * z + z * x;
+}
+
+/* Compared before the conversion, a centroid that overflows lands in the
+last bin */
+static size_t bvh_bin(mfloat_t *b0, mfloat_t *c0, int axis, mfloat_t scale)
+{
+	mfloat_t bin = ((b0[axis] + b0[3 + axis]) * MFLOAT_C(0.5) - c0[axis]) * scale;
+	return bin < (mfloat_t)BVH_BINS ? (size_t)bin : BVH_BINS - 1;
+}
+
+/* Partitions `indices` along the axis where the centroids `c0` (as an
+AABB) spread the most, at the bin boundary with the lowest surface area
+cost. Returns the number of primitives on the left, never zero or `count` */
+static size_t bvh_split(mfloat_t *b0, uint32_t *indices, size_t count, mfloat_t *c0)
+{
+	mfloat_t bins[BVH_BINS][AABB_SIZE];
+	size_t bin_count[BVH_BINS] = {0};
+	mfloat_t right_area[BVH_BINS];
+	size_t right_count[BVH_BINS];
+	mfloat_t bounds[AABB_SIZE];
+	mfloat_t best_cost = INFINITY;
+	mfloat_t scale;
+	size_t left_count = 0;
+	size_t best = 0;
+	size_t left = 0;
+	size_t right = count;
+	int axis = 0;
+	for (int j = 1; j < 3; j++) {
+		if (c0[3 + j] - c0[j] > c0[3 + axis] - c0[axis]) {
+			axis = j;
+		}
+	}
+	if (!(c0[3 + axis] > c0[axis])) {
+		/* Every centroid is at the same place, any split is as good */
+		return count / 2;
+	}
+	scale = (mfloat_t)BVH_BINS / (c0[3 + axis] - c0[axis]);
+	if (!(scale < MFLT_MAX)) {
+		/* The centroids are too close to be binned, same as above */
+		return count / 2;
+	}
+	for (int k = 0; k < BVH_BINS; k++) {
+		aabb_from_points_n(bins[k], NULL, 0);
+	}
+	for (size_t i = 0; i < count; i++) {
+		mfloat_t *b = b0 + indices[i] * AABB_SIZE;
+		size_t k = bvh_bin(b, c0, axis, scale);
+		bin_count[k]++;
+		aabb_union(bins[k], bins[k], b);
+	}
+	/* Sweep from the right to know the cost of each right side, then
+	from the left to pick the cheapest boundary */
+	aabb_from_points_n(bounds, NULL, 0);
+	right_count[BVH_BINS - 1] = 0;
+	for (int k = BVH_BINS - 1; k > 0; k--) {
+		aabb_union(bounds, bounds, bins[k]);
+		right_count[k - 1] = right_count[k] + bin_count[k];
+		right_area[k - 1] = aabb_half_area(bounds);
+	}
+	aabb_from_points_n(bounds, NULL, 0);
+	for (int k = 0; k < BVH_BINS - 1; k++) {
+		aabb_union(bounds, bounds, bins[k]);
+		left_count += bin_count[k];
+		if (left_count > 0 && right_count[k] > 0) {
+			mfloat_t cost = aabb_half_area(bounds) * (mfloat_t)left_count + right_area[k] * (mfloat_t)right_count[k];
+			if (cost < best_cost) {
+				best_cost = cost;
+				best = (size_t)k;
+			}
+		}
+	}
+	while (left < right) {
+		if (bvh_bin(b0 + indices[left] * AABB_SIZE, c0, axis, scale) <= best) {
+			left++;
+		} else {
+			uint32_t index = indices[left];
+			right--;
+			indices[left] = indices[right];
+			indices[right] = index;
+		}
+	}
+	return left;
+}
+
+static void bvh_build_node(struct bvh *bvh, mfloat_t *b0, size_t node, size_t first, size_t count, int depth)
+{
+	for (;;) {
+		struct bvh_node *n = bvh->nodes + node;
+		uint32_t *indices = bvh->indices + first;
+		mfloat_t centroids[AABB_SIZE];
+		size_t split;
+		size_t children;
+		aabb_from_points_n(n->bounds, NULL, 0);
+		aabb_from_points_n(centroids, NULL, 0);
+		for (size_t i = 0; i < count; i++) {
+			mfloat_t *b = b0 + indices[i] * AABB_SIZE;
+			for (int j = 0; j < 3; j++) {
+				mfloat_t c = (b[j] + b[3 + j]) * MFLOAT_C(0.5);
+				centroids[j] = MFMIN(centroids[j], c);
+				centroids[3 + j] = MFMAX(centroids[3 + j], c);
+			}
+			aabb_union(n->bounds, n->bounds, b);
+		}
+		if (count <= BVH_LEAF_SIZE || depth >= BVH_MAX_DEPTH - 1) {
+			n->first = (uint32_t)first;
+			n->count = (uint32_t)count;
+			return;
+		}
+		split = bvh_split(b0, indices, count, centroids);
+		children = bvh->node_count;
+		bvh->node_count = bvh->node_count + 2;
+		n->first = (uint32_t)children;
+		n->count = 0;
+		depth++;
+		/* Recurse into the smaller side only, so the recursion depth
+		stays logarithmic */
+		if (split < count - split) {
+			bvh_build_node(bvh, b0, children, first, split, depth);
+			node = children + 1;
+			first = first + split;
+			count = count - split;
+		} else {
+			bvh_build_node(bvh, b0, children + 1, first + split, count - split, depth);
+			node = children;
+			count = split;
+		}
+	}
+}
+
+/* Builds the hierarchy over the `bvh->count` boxes in `b0`, which must be
+less than 2^32. For triangles, the boxes are given by aabb_from_points_n() */
+void bvh_build(struct bvh *bvh, mfloat_t *b0)
+{
+	bvh->node_count = 0;
+	if (bvh->count == 0) {
+		return;
+	}
+	for (size_t i = 0; i < bvh->count; i++) {
+		bvh->indices[i] = (uint32_t)i;
+	}
+	bvh->node_count = 1;
+	bvh_build_node(bvh, b0, 0, 0, bvh->count, 0);
+}
+
+/* Shared traversal of the ray queries, stops at the first hit when
+`any` is set. Returns the index of the triangle hit or `bvh->count` */
+static size_t bvh_intersect(struct bvh *bvh, mfloat_t *result, mfloat_t *r0, mfloat_t *t0, mfloat_t t_max, bool any)
+{
+	uint32_t stack[BVH_MAX_DEPTH];
+	mfloat_t inverse[RAY_SIZE];
+	mfloat_t hit[VEC3_SIZE];
+	mfloat_t entry;
+	size_t closest = bvh->count;
+	int top = 0;
+	uint32_t node = 0;
+	if (bvh->node_count == 0 || !ray_intersect_aabb(&entry, ray_inverse_direction(inverse, r0), bvh->nodes[0].bounds, t_max)) {
+		return closest;
+	}
+	for (;;) {
+		struct bvh_node *n = bvh->nodes + node;
+		if (n->count > 0) {
+			for (uint32_t i = n->first; i < n->first + n->count; i++) {
+				mfloat_t *t = t0 + bvh->indices[i] * TRIANGLE_SIZE;
+				if (ray_intersect_triangle(hit, r0, t, t + 3, t + 6) && hit[0] < t_max) {
+					vec3_assign(result, hit);
+					t_max = hit[0];
+					closest = bvh->indices[i];
+					if (any) {
+						return closest;
+					}
+				}
+			}
+		} else {
+			mfloat_t entry_left;
+			mfloat_t entry_right;
+			bool left = ray_intersect_aabb(&entry_left, inverse, bvh->nodes[n->first].bounds, t_max);
+			bool right = ray_intersect_aabb(&entry_right, inverse, bvh->nodes[n->first + 1].bounds, t_max);
+			if (left && right) {
+				/* Visit the nearest child first and keep the other one */
+				bool swap = entry_right < entry_left;
+				node = n->first + swap;
+				stack[top++] = n->first + !swap;
+				continue;
+			} else if (left || right) {
+				node = n->first + right;
+				continue;
+			}
+		}
+		/* Pop the next child still in front of the closest hit */
+		do {
+			if (top == 0) {
+				return closest;
+			}
+			node = stack[--top];
+		} while (!ray_intersect_aabb(&entry, inverse, bvh->nodes[node].bounds, t_max));
+	}
+}
+
+/* Finds the closest triangle of `t0` hit by the ray before `t_max`, the
+hierarchy being built over their boxes. `result` receives the distance and
+the barycentric coordinates as ray_intersect_triangle(). Returns the index
+of the triangle, or `bvh->count` when nothing is hit */
+size_t bvh_intersect_triangles(struct bvh *bvh, mfloat_t *result, mfloat_t *r0, mfloat_t *t0, mfloat_t t_max)
+{
+	return bvh_intersect(bvh, result, r0, t0, t_max, false);
+}
+
+/* Returns true if any triangle of `t0` is hit by the ray before `t_max` */
+bool bvh_occluded_triangles(struct bvh *bvh, mfloat_t *r0, mfloat_t *t0, mfloat_t t_max)
+{
+	mfloat_t hit[VEC3_SIZE];
+	return bvh_intersect(bvh, hit, r0, t0, t_max, true) != bvh->count;
+}
+
+/* Writes to `result` the indices of the boxes of `b0`, the ones the
+hierarchy was built over, that overlap `b1`. At most `capacity` indices
+are written, the return value is the number of boxes overlapping */
+size_t bvh_overlap_aabb(struct bvh *bvh, uint32_t *result, size_t capacity, mfloat_t *b0, mfloat_t *b1)
+{
+	uint32_t stack[BVH_MAX_DEPTH];
+	size_t overlaps = 0;
+	int top = 0;
+	if (bvh->node_count == 0) {
+		return 0;
+	}
+	stack[top++] = 0;
+	while (top > 0) {
+		struct bvh_node *n = bvh->nodes + stack[--top];
+		while (aabb_intersects(n->bounds, b1)) {
+			if (n->count > 0) {
+				for (uint32_t i = n->first; i < n->first + n->count; i++) {
+					uint32_t index = bvh->indices[i];
+					if (aabb_intersects(b0 + index * AABB_SIZE, b1)) {
+						if (overlaps < capacity) {
+							result[overlaps] = index;
+						}
+						overlaps++;
+					}
+				}
+				break;
+			}
+			stack[top++] = n->first + 1;
+			n = bvh->nodes + n->first;
+		}
+	}
+	return overlaps;
+}
+
+void aabb_tree_init(struct aabb_tree *tree, struct aabb_tree_node *nodes, size_t capacity, mfloat_t margin)
+{
+	tree->nodes = nodes;
+	tree->capacity = capacity;
+	tree->node_count = 0;
+	tree->root = AABB_TREE_NULL;
+	tree->free = capacity > 0 ? 0 : AABB_TREE_NULL;
+	tree->margin = margin;
+	for (size_t i = 0; i < capacity; i++) {
+		nodes[i].parent = i + 1 < capacity ? (uint32_t)(i + 1) : AABB_TREE_NULL;
+		nodes[i].height = -1;
+	}
+}
+
+static uint32_t aabb_tree_allocate(struct aabb_tree *tree)
+{
+	uint32_t node = tree->free;
+	struct aabb_tree_node *n = tree->nodes + node;
+	tree->free = n->parent;
+	tree->node_count++;
+	n->parent = AABB_TREE_NULL;
+	n->left = AABB_TREE_NULL;
+	n->right = AABB_TREE_NULL;
+	n->height = 0;
+	return node;
+}
+
+static void aabb_tree_release(struct aabb_tree *tree, uint32_t node)
+{
+	tree->nodes[node].parent = tree->free;
+	tree->nodes[node].height = -1;
+	tree->free = node;
+	tree->node_count--;
+}
+
+static void aabb_tree_replace_child(struct aabb_tree *tree, uint32_t parent, uint32_t child, uint32_t node)
+{
+	if (parent == AABB_TREE_NULL) {
+		tree->root = node;
+	} else if (tree->nodes[parent].left == child) {
+		tree->nodes[parent].left = node;
+	} else {
+		tree->nodes[parent].right = node;
+	}
+}
+
+/* Finishes a rotation: `a` takes `kept` and `moved` as children and
+`b`, now the parent of `a`, takes `up` as its other child */
+static void aabb_tree_rotate(struct aabb_tree *tree, uint32_t a, uint32_t b, uint32_t kept, uint32_t moved, uint32_t up)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	nodes[moved].parent = a;
+	aabb_union(nodes[a].bounds, nodes[kept].bounds, nodes[moved].bounds);
+	nodes[a].height = 1 + (nodes[kept].height > nodes[moved].height ? nodes[kept].height : nodes[moved].height);
+	aabb_union(nodes[b].bounds, nodes[a].bounds, nodes[up].bounds);
+	nodes[b].height = 1 + (nodes[a].height > nodes[up].height ? nodes[a].height : nodes[up].height);
+}
+
+/* Rotates the taller child of `a` up when the heights of its children
+differ by more than one. Returns the node now at the place of `a` */
+static uint32_t aabb_tree_balance(struct aabb_tree *tree, uint32_t a)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	uint32_t b = nodes[a].left;
+	uint32_t c = nodes[a].right;
+	int32_t balance;
+	if (nodes[a].height < 2) {
+		return a;
+	}
+	balance = nodes[c].height - nodes[b].height;
+	if (balance > 1) {
+		uint32_t f = nodes[c].left;
+		uint32_t g = nodes[c].right;
+		nodes[c].left = a;
+		nodes[c].parent = nodes[a].parent;
+		nodes[a].parent = c;
+		aabb_tree_replace_child(tree, nodes[c].parent, a, c);
+		if (nodes[f].height > nodes[g].height) {
+			nodes[c].right = f;
+			nodes[a].right = g;
+			aabb_tree_rotate(tree, a, c, b, g, f);
+		} else {
+			nodes[c].right = g;
+			nodes[a].right = f;
+			aabb_tree_rotate(tree, a, c, b, f, g);
+		}
+		return c;
+	}
+	if (balance < -1) {
+		uint32_t d = nodes[b].left;
+		uint32_t e = nodes[b].right;
+		nodes[b].left = a;
+		nodes[b].parent = nodes[a].parent;
+		nodes[a].parent = b;
+		aabb_tree_replace_child(tree, nodes[b].parent, a, b);
+		if (nodes[d].height > nodes[e].height) {
+			nodes[b].right = d;
+			nodes[a].left = e;
+			aabb_tree_rotate(tree, a, b, c, e, d);
+		} else {
+			nodes[b].right = e;
+			nodes[a].left = d;
+			aabb_tree_rotate(tree, a, b, c, d, e);
+		}
+		return b;
+	}
+	return a;
+}
+
+/* Balances and refits the ancestors of a node, up to the root */
+static void aabb_tree_refit(struct aabb_tree *tree, uint32_t node)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	while (node != AABB_TREE_NULL) {
+		uint32_t left;
+		uint32_t right;
+		node = aabb_tree_balance(tree, node);
+		left = nodes[node].left;
+		right = nodes[node].right;
+		nodes[node].height = 1 + (nodes[left].height > nodes[right].height ? nodes[left].height : nodes[right].height);
+		aabb_union(nodes[node].bounds, nodes[left].bounds, nodes[right].bounds);
+		node = nodes[node].parent;
+	}
+}
+
+/* Catto, the sibling is found by descending towards the child whose
+bounds grow the least, until pairing with the current node is cheaper */
+static void aabb_tree_insert_leaf(struct aabb_tree *tree, uint32_t leaf)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	mfloat_t *bounds = nodes[leaf].bounds;
+	mfloat_t combined[AABB_SIZE];
+	uint32_t sibling = tree->root;
+	uint32_t parent;
+	if (sibling == AABB_TREE_NULL) {
+		tree->root = leaf;
+		nodes[leaf].parent = AABB_TREE_NULL;
+		return;
+	}
+	while (nodes[sibling].height > 0) {
+		uint32_t children[2];
+		mfloat_t child_cost[2];
+		mfloat_t area = aabb_half_area(nodes[sibling].bounds);
+		mfloat_t combined_area = aabb_half_area(aabb_union(combined, nodes[sibling].bounds, bounds));
+		mfloat_t cost = MFLOAT_C(2.0) * combined_area;
+		mfloat_t inheritance = MFLOAT_C(2.0) * (combined_area - area);
+		children[0] = nodes[sibling].left;
+		children[1] = nodes[sibling].right;
+		for (int i = 0; i < 2; i++) {
+			struct aabb_tree_node *child = nodes + children[i];
+			child_cost[i] = aabb_half_area(aabb_union(combined, child->bounds, bounds)) + inheritance;
+			if (child->height > 0) {
+				child_cost[i] = child_cost[i] - aabb_half_area(child->bounds);
+			}
+		}
+		if (cost < child_cost[0] && cost < child_cost[1]) {
+			break;
+		}
+		sibling = child_cost[0] < child_cost[1] ? children[0] : children[1];
+	}
+	parent = aabb_tree_allocate(tree);
+	nodes[parent].parent = nodes[sibling].parent;
+	nodes[parent].left = sibling;
+	nodes[parent].right = leaf;
+	nodes[parent].height = nodes[sibling].height + 1;
+	aabb_union(nodes[parent].bounds, nodes[sibling].bounds, bounds);
+	aabb_tree_replace_child(tree, nodes[sibling].parent, sibling, parent);
+	nodes[sibling].parent = parent;
+	nodes[leaf].parent = parent;
+	aabb_tree_refit(tree, nodes[parent].parent);
+}
+
+static void aabb_tree_remove_leaf(struct aabb_tree *tree, uint32_t leaf)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	uint32_t parent = nodes[leaf].parent;
+	uint32_t grandparent;
+	uint32_t sibling;
+	if (parent == AABB_TREE_NULL) {
+		tree->root = AABB_TREE_NULL;
+		return;
+	}
+	grandparent = nodes[parent].parent;
+	sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+	aabb_tree_replace_child(tree, grandparent, parent, sibling);
+	nodes[sibling].parent = grandparent;
+	aabb_tree_release(tree, parent);
+	aabb_tree_refit(tree, grandparent);
+}
+
+static void aabb_tree_fatten(struct aabb_tree *tree, uint32_t leaf, mfloat_t *b0)
+{
+	mfloat_t *bounds = tree->nodes[leaf].bounds;
+	for (int i = 0; i < 3; i++) {
+		bounds[i] = b0[i] - tree->margin;
+		bounds[3 + i] = b0[3 + i] + tree->margin;
+	}
+}
+
+/* Returns the leaf holding the object, which identifies it in the other
+functions, or AABB_TREE_NULL when the pool is full */
+uint32_t aabb_tree_insert(struct aabb_tree *tree, mfloat_t *b0)
+{
+	uint32_t leaf;
+	if (tree->node_count + (tree->root == AABB_TREE_NULL ? 1 : 2) > tree->capacity) {
+		return AABB_TREE_NULL;
+	}
+	leaf = aabb_tree_allocate(tree);
+	aabb_tree_fatten(tree, leaf, b0);
+	aabb_tree_insert_leaf(tree, leaf);
+	return leaf;
+}
+
+void aabb_tree_remove(struct aabb_tree *tree, uint32_t leaf)
+{
+	aabb_tree_remove_leaf(tree, leaf);
+	aabb_tree_release(tree, leaf);
+}
+
+/* Updates the bounds of an object. Nothing is done while the new bounds
+stay inside the fattened ones, returns true if the leaf was reinserted */
+bool aabb_tree_move(struct aabb_tree *tree, uint32_t leaf, mfloat_t *b0)
+{
+	if (aabb_contains(tree->nodes[leaf].bounds, b0)) {
+		return false;
+	}
+	aabb_tree_remove_leaf(tree, leaf);
+	aabb_tree_fatten(tree, leaf, b0);
+	aabb_tree_insert_leaf(tree, leaf);
+	return true;
+}
+
+/* Writes to `result` the leaves whose fattened bounds overlap `b0`. At
+most `capacity` leaves are written, the return value is the number of
+leaves overlapping */
+size_t aabb_tree_overlap_aabb(struct aabb_tree *tree, uint32_t *result, size_t capacity, mfloat_t *b0)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	uint32_t stack[AABB_TREE_MAX_HEIGHT];
+	size_t overlaps = 0;
+	int top = 0;
+	if (tree->root == AABB_TREE_NULL) {
+		return 0;
+	}
+	stack[top++] = tree->root;
+	while (top > 0) {
+		uint32_t node = stack[--top];
+		while (aabb_intersects(nodes[node].bounds, b0)) {
+			if (nodes[node].height == 0) {
+				if (overlaps < capacity) {
+					result[overlaps] = node;
+				}
+				overlaps++;
+				break;
+			}
+			stack[top++] = nodes[node].right;
+			node = nodes[node].left;
+		}
+	}
+	return overlaps;
+}
+
+/* Writes to `result` the leaves whose fattened bounds are hit by the ray
+before `t_max`, as aabb_tree_overlap_aabb() */
+size_t aabb_tree_intersect_ray(struct aabb_tree *tree, uint32_t *result, size_t capacity, mfloat_t *r0, mfloat_t t_max)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	uint32_t stack[AABB_TREE_MAX_HEIGHT];
+	mfloat_t inverse[RAY_SIZE];
+	mfloat_t entry;
+	size_t hits = 0;
+	int top = 0;
+	if (tree->root == AABB_TREE_NULL) {
+		return 0;
+	}
+	ray_inverse_direction(inverse, r0);
+	stack[top++] = tree->root;
+	while (top > 0) {
+		uint32_t node = stack[--top];
+		while (ray_intersect_aabb(&entry, inverse, nodes[node].bounds, t_max)) {
+			if (nodes[node].height == 0) {
+				if (hits < capacity) {
+					result[hits] = node;
+				}
+				hits++;
+				break;
+			}
+			stack[top++] = nodes[node].right;
+			node = nodes[node].left;
+		}
+	}
+	return hits;
+}
+
+/* Writes to `result` the pairs of leaves whose fattened bounds overlap,
+two indices per pair with the lowest first. At most `capacity` pairs are
+written, the return value is the number of pairs */
+size_t aabb_tree_pairs(struct aabb_tree *tree, uint32_t *result, size_t capacity)
+{
+	struct aabb_tree_node *nodes = tree->nodes;
+	uint32_t stack[AABB_TREE_MAX_HEIGHT];
+	size_t pairs = 0;
+	for (size_t i = 0; i < tree->capacity; i++) {
+		mfloat_t *bounds = nodes[i].bounds;
+		int top = 0;
+		if (nodes[i].height != 0) {
+			continue;
+		}
+		stack[top++] = tree->root;
+		while (top > 0) {
+			uint32_t node = stack[--top];
+			while (aabb_intersects(nodes[node].bounds, bounds)) {
+				if (nodes[node].height == 0) {
+					if (node > i) {
+						if (pairs < capacity) {
+							result[pairs * 2] = (uint32_t)i;
+							result[pairs * 2 + 1] = node;
+						}
+						pairs++;
+					}
+					break;
+				}
+				stack[top++] = nodes[node].right;
+				node = nodes[node].left;
+			}
+		}
+	}
+	return pairs;
+}
+
+#if defined(MATHC_USE_INT)
+/* The cell containing a point, the coordinates must fit in mint_t */
+mint_t *spatial_hash_cell(mint_t *result, mfloat_t *v0, mfloat_t cell_size)
+{
+	result[0] = (mint_t)MFLOOR(v0[0] / cell_size);
+	result[1] = (mint_t)MFLOOR(v0[1] / cell_size);
+	result[2] = (mint_t)MFLOOR(v0[2] / cell_size);
+	return result;
+}
+
+/* Teschner et al., the XOR of the coordinates multiplied by large primes */
+size_t spatial_hash_bucket(struct spatial_hash *hash, mint_t *v0)
+{
+	uint32_t key = ((uint32_t)v0[0] * UINT32_C(73856093)) ^ ((uint32_t)v0[1] * UINT32_C(19349663)) ^ ((uint32_t)v0[2] * UINT32_C(83492791));
+	return key & (hash->bucket_count - 1);
+}
+
+static mfloat_t *spatial_hash_point(mfloat_t *result, struct spatial_hash *hash, uint32_t i)
+{
+	result[0] = hash->x[i];
+	result[1] = hash->y[i];
+	result[2] = hash->z[i];
+	return result;
+}
+
+/* Rebuilds the grid over `count` points with a counting sort of their
+buckets. `radius` is NULL for points, or the radius of each sphere */
+void spatial_hash_build(struct spatial_hash *hash, mfloat_t *x, mfloat_t *y, mfloat_t *z, mfloat_t *radius, size_t count)
+{
+	uint32_t *buckets = hash->buckets;
+	mfloat_t point[VEC3_SIZE];
+	mint_t cell[VEC3_SIZE];
+	hash->count = count;
+	hash->x = x;
+	hash->y = y;
+	hash->z = z;
+	hash->radius = radius;
+	hash->max_radius = MFLOAT_C(0.0);
+	for (int j = 0; j < 3; j++) {
+		hash->min[j] = 0;
+		hash->max[j] = 0;
+	}
+	for (size_t i = 0; i <= hash->bucket_count; i++) {
+		buckets[i] = 0;
+	}
+	for (size_t i = 0; i < count; i++) {
+		spatial_hash_cell(cell, spatial_hash_point(point, hash, (uint32_t)i), hash->cell_size);
+		for (int j = 0; j < 3; j++) {
+			hash->min[j] = i == 0 || cell[j] < hash->min[j] ? cell[j] : hash->min[j];
+			hash->max[j] = i == 0 || cell[j] > hash->max[j] ? cell[j] : hash->max[j];
+		}
+		if (radius != NULL) {
+			hash->max_radius = MFMAX(hash->max_radius, radius[i]);
+		}
+		hash->keys[i] = (uint32_t)spatial_hash_bucket(hash, cell);
+		buckets[hash->keys[i]]++;
+	}
+	/* Each offset is first the end of its bucket, then scattering in
+	reverse moves it to the start and keeps the entries in order */
+	for (size_t i = 1; i < hash->bucket_count; i++) {
+		buckets[i] = buckets[i] + buckets[i - 1];
+	}
+	for (size_t i = count; i > 0; i--) {
+		hash->entries[--buckets[hash->keys[i - 1]]] = (uint32_t)(i - 1);
+	}
+	buckets[hash->bucket_count] = (uint32_t)count;
+}
+
+/* Writes to `result` the points within `radius` of `v0`, or the spheres
+overlapping the sphere of that radius. At most `capacity` indices are
+written, the return value is the number found */
+size_t spatial_hash_query_radius(struct spatial_hash *hash, uint32_t *result, size_t capacity, mfloat_t *v0, mfloat_t radius)
+{
+	mfloat_t reach = radius + hash->max_radius;
+	mfloat_t corner[VEC3_SIZE];
+	mfloat_t point[VEC3_SIZE];
+	mint_t min[VEC3_SIZE];
+	mint_t max[VEC3_SIZE];
+	mint_t cell[VEC3_SIZE];
+	mint_t point_cell[VEC3_SIZE];
+	size_t found = 0;
+	if (hash->count == 0) {
+		return 0;
+	}
+	spatial_hash_cell(min, vec3_subtract_f(corner, v0, reach), hash->cell_size);
+	spatial_hash_cell(max, vec3_add_f(corner, v0, reach), hash->cell_size);
+	vec3i_max(min, min, hash->min);
+	vec3i_min(max, max, hash->max);
+	for (cell[2] = min[2]; cell[2] <= max[2]; cell[2]++) {
+		for (cell[1] = min[1]; cell[1] <= max[1]; cell[1]++) {
+			for (cell[0] = min[0]; cell[0] <= max[0]; cell[0]++) {
+				size_t bucket = spatial_hash_bucket(hash, cell);
+				for (uint32_t i = hash->buckets[bucket]; i < hash->buckets[bucket + 1]; i++) {
+					uint32_t index = hash->entries[i];
+					mfloat_t limit = radius + (hash->radius != NULL ? hash->radius[index] : MFLOAT_C(0.0));
+					spatial_hash_point(point, hash, index);
+					/* Other cells can share the bucket */
+					if (!vec3i_is_equal(spatial_hash_cell(point_cell, point, hash->cell_size), cell)) {
+						continue;
+					}
+					if (vec3_distance_squared(point, v0) <= limit * limit) {
+						if (found < capacity) {
+							result[found] = index;
+						}
+						found++;
+					}
+				}
+			}
+		}
+	}
+	return found;
+}
+
+/* Adds the points of the cells from `min` to `max`, clamped to the occupied
+cells, to the `found` closest points sorted in `result` and `distances` */
+static size_t spatial_hash_nearest_cells(struct spatial_hash *hash, uint32_t *result, mfloat_t *distances, size_t k, size_t found, mfloat_t *v0, mfloat_t max_squared, mint_t *min, mint_t *max)
+{
+	mfloat_t point[VEC3_SIZE];
+	mint_t first[VEC3_SIZE];
+	mint_t last[VEC3_SIZE];
+	mint_t cell[VEC3_SIZE];
+	mint_t point_cell[VEC3_SIZE];
+	vec3i_max(first, min, hash->min);
+	vec3i_min(last, max, hash->max);
+	for (cell[2] = first[2]; cell[2] <= last[2]; cell[2]++) {
+		for (cell[1] = first[1]; cell[1] <= last[1]; cell[1]++) {
+			for (cell[0] = first[0]; cell[0] <= last[0]; cell[0]++) {
+				size_t bucket = spatial_hash_bucket(hash, cell);
+				for (uint32_t i = hash->buckets[bucket]; i < hash->buckets[bucket + 1]; i++) {
+					uint32_t index = hash->entries[i];
+					mfloat_t squared;
+					size_t j;
+					spatial_hash_point(point, hash, index);
+					if (!vec3i_is_equal(spatial_hash_cell(point_cell, point, hash->cell_size), cell)) {
+						continue;
+					}
+					squared = vec3_distance_squared(point, v0);
+					if (squared > max_squared || (found == k && squared >= distances[k - 1])) {
+						continue;
+					}
+					/* Insertion in the sorted results, dropping the farthest */
+					j = found < k ? found++ : k - 1;
+					for (; j > 0 && distances[j - 1] > squared; j--) {
+						distances[j] = distances[j - 1];
+						result[j] = result[j - 1];
+					}
+					distances[j] = squared;
+					result[j] = index;
+				}
+			}
+		}
+	}
+	return found;
+}
+
+/* Writes to `result` the up to `k` points closest to `v0` within
+`max_distance`, sorted from the closest, and their distance to
+`distances`. Cells are searched in growing shells around the cell of
+`v0`, starting from the first shell reaching the occupied cells, until no
+unvisited point can be closer. Returns the number found */
+size_t spatial_hash_query_nearest(struct spatial_hash *hash, uint32_t *result, mfloat_t *distances, size_t k, mfloat_t *v0, mfloat_t max_distance)
+{
+	mfloat_t max_squared = max_distance * max_distance;
+	mint_t center[VEC3_SIZE];
+	mint_t min[VEC3_SIZE];
+	mint_t max[VEC3_SIZE];
+	mint_t start = 0;
+	size_t found = 0;
+	if (hash->count == 0 || k == 0) {
+		return 0;
+	}
+	spatial_hash_cell(center, v0, hash->cell_size);
+	for (int j = 0; j < 3; j++) {
+		start = hash->min[j] - center[j] > start ? hash->min[j] - center[j] : start;
+		start = center[j] - hash->max[j] > start ? center[j] - hash->max[j] : start;
+	}
+	for (mint_t d = start;; d++) {
+		bool covered = true;
+		for (int j = 0; j < 3; j++) {
+			covered = covered && center[j] - d <= hash->min[j] && center[j] + d >= hash->max[j];
+		}
+		/* Only the six faces of the cube are new in this shell: the two
+		faces on z, then those on y and x without the edges already seen */
+		for (mint_t side = -d; side <= d; side = side + (d > 0 ? 2 * d : 1)) {
+			vec3i(min, center[0] - d, center[1] - d, center[2] + side);
+			vec3i(max, center[0] + d, center[1] + d, center[2] + side);
+			found = spatial_hash_nearest_cells(hash, result, distances, k, found, v0, max_squared, min, max);
+			vec3i(min, center[0] - d, center[1] + side, center[2] - d + 1);
+			vec3i(max, center[0] + d, center[1] + side, center[2] + d - 1);
+			found = spatial_hash_nearest_cells(hash, result, distances, k, found, v0, max_squared, min, max);
+			vec3i(min, center[0] + side, center[1] - d + 1, center[2] - d + 1);
+			vec3i(max, center[0] + side, center[1] + d - 1, center[2] + d - 1);
+			found = spatial_hash_nearest_cells(hash, result, distances, k, found, v0, max_squared, min, max);
+		}
+		/* Unvisited points are more than d cells away on some axis */
+		if (covered
+			|| (mfloat_t)d * hash->cell_size > max_distance
+			|| (found == k && distances[k - 1] <= (mfloat_t)d * hash->cell_size * (mfloat_t)d * hash->cell_size)) {
+			break;
+		}
+	}
+	for (size_t i = 0; i < found; i++) {
+		distances[i] = MSQRT(distances[i]);
+	}
+	return found;
+}
+#endif
+
+#if defined(MATHC_USE_INT)
+/* Node of the linear octree, with the range of the cells it contains */
+struct linear_octree_node {
+	uint64_t key;
+	int level;
+	size_t first;
+	size_t last;
+};
+
+/* Enough for the children left to visit on the way down an octree */
+#define LINEAR_OCTREE_STACK_SIZE (LINEAR_OCTREE_MAX_DEPTH * 7 + 1)
+
+/* The code of a cell, or of a node in the grid of its level */
+uint64_t linear_octree_key(struct linear_octree *tree, mint_t *v0)
+{
+	return tree->dimensions == 3 ? vec3i_to_morton64(v0) : vec2i_to_morton64(v0);
+}
+
+static mint_t *linear_octree_cell(struct linear_octree *tree, mint_t *result, uint64_t key)
+{
+	return tree->dimensions == 3 ? vec3i_from_morton64(result, key) : vec2i_from_morton64(result, key);
+}
+
+/* The first key at or after `key` in the cells from `first` to `last` */
+static size_t linear_octree_lower_bound(struct linear_octree *tree, uint64_t key, size_t first, size_t last)
+{
+	while (first < last) {
+		size_t middle = first + (last - first) / 2;
+		if (tree->keys[middle] < key) {
+			first = middle + 1;
+		} else {
+			last = middle;
+		}
+	}
+	return first;
+}
+
+/* Splits a node into its non-empty children, in Morton order */
+static int linear_octree_children(struct linear_octree *tree, struct linear_octree_node *result, struct linear_octree_node *node)
+{
+	int shift = tree->dimensions * (tree->depth - node->level - 1);
+	int child_count = 1 << tree->dimensions;
+	size_t first = node->first;
+	int count = 0;
+	for (int i = 0; i < child_count; i++) {
+		uint64_t key = (node->key << tree->dimensions) | (uint64_t)i;
+		size_t last = i + 1 < child_count ? linear_octree_lower_bound(tree, (key + 1) << shift, first, node->last) : node->last;
+		if (last > first) {
+			result[count].key = key;
+			result[count].level = node->level + 1;
+			result[count].first = first;
+			result[count].last = last;
+			count++;
+		}
+		first = last;
+	}
+	return count;
+}
+
+/* Builds the tree over the `count` points of `v0`, with `dimensions`
+coordinates each and clamped to the grid. Occupied cells are sorted with
+morton64_sort_n(), so `keys` and the scratch arrays hold `count` elements,
+and `indices` keeps the point of each sorted code before duplicates are
+removed. Returns the number of occupied cells, 0 when `dimensions` is not
+2 or 3 or `depth` is out of the limits of the tree */
+size_t linear_octree_build(struct linear_octree *tree, mfloat_t *v0, size_t count, uint64_t *keys_scratch, uint32_t *indices, uint32_t *indices_scratch)
+{
+	int max_depth = tree->dimensions == 3 ? LINEAR_OCTREE_MAX_DEPTH : LINEAR_QUADTREE_MAX_DEPTH;
+	mfloat_t size;
+	mint_t limit;
+	mint_t cell[VEC3_SIZE];
+	size_t unique = 0;
+	tree->count = 0;
+	if ((tree->dimensions != 2 && tree->dimensions != 3) || tree->depth < 0 || tree->depth > max_depth) {
+		return 0;
+	}
+	/* The grid size is a power of two, exact in any precision, so the
+	cells are compared with it before the conversion and clamped as
+	integers */
+	size = (mfloat_t)((uint64_t)1 << tree->depth);
+	limit = (mint_t)(((uint64_t)1 << tree->depth) - 1);
+	for (size_t i = 0; i < count; i++) {
+		mfloat_t *point = v0 + i * (size_t)tree->dimensions;
+		for (int j = 0; j < tree->dimensions; j++) {
+			mfloat_t c = MFLOOR((point[j] - tree->origin[j]) / tree->cell_size);
+			if (!(c > MFLOAT_C(0.0))) {
+				cell[j] = 0;
+			} else if (c >= size) {
+				cell[j] = limit;
+			} else {
+				cell[j] = (mint_t)c;
+			}
+		}
+		tree->keys[i] = linear_octree_key(tree, cell);
+	}
+	morton64_sort_n(tree->keys, indices, keys_scratch, indices_scratch, count);
+	for (size_t i = 0; i < count; i++) {
+		if (unique == 0 || tree->keys[i] != tree->keys[unique - 1]) {
+			tree->keys[unique] = tree->keys[i];
+			unique++;
+		}
+	}
+	tree->count = unique;
+	return unique;
+}
+
+/* Finds the cells of the node at `v0` in the grid of `level`. Returns
+their number, the first one is written to `first` */
+size_t linear_octree_range(struct linear_octree *tree, size_t *first, mint_t *v0, int level)
+{
+	int shift = tree->dimensions * (tree->depth - level);
+	uint64_t key = linear_octree_key(tree, v0);
+	size_t begin = linear_octree_lower_bound(tree, key << shift, 0, tree->count);
+	size_t end = linear_octree_lower_bound(tree, (key + 1) << shift, begin, tree->count);
+	*first = begin;
+	return end - begin;
+}
+
+/* Writes to `result` the coordinates of the non-empty nodes next to `v0`
+in the grid of `level`, sharing a face, an edge or a corner. Returns
+their number, up to 26 for an octree and 8 for a quadtree */
+size_t linear_octree_neighbors(struct linear_octree *tree, mint_t *result, mint_t *v0, int level)
+{
+	int64_t size = (int64_t)1 << level;
+	int offset_count = tree->dimensions == 3 ? 27 : 9;
+	mint_t neighbor[VEC3_SIZE];
+	size_t found = 0;
+	for (int i = 0; i < offset_count; i++) {
+		bool inside = i != offset_count / 2;
+		size_t first;
+		int offset = i;
+		for (int j = 0; j < tree->dimensions; j++) {
+			int64_t n = (int64_t)v0[j] + offset % 3 - 1;
+			inside = inside && n >= 0 && n < size;
+			neighbor[j] = (mint_t)n;
+			offset = offset / 3;
+		}
+		if (inside && linear_octree_range(tree, &first, neighbor, level) > 0) {
+			for (int j = 0; j < tree->dimensions; j++) {
+				result[found * (size_t)tree->dimensions + (size_t)j] = neighbor[j];
+			}
+			found++;
+		}
+	}
+	return found;
+}
+
+/* The overlap of a node with the cells from `v0` to `v1` included, 0 when
+apart, 1 when crossing and 2 when contained */
+static int linear_octree_overlap(struct linear_octree *tree, struct linear_octree_node *node, mint_t *v0, mint_t *v1)
+{
+	int shift = tree->depth - node->level;
+	mint_t cell[VEC3_SIZE];
+	int overlap = 2;
+	linear_octree_cell(tree, cell, node->key);
+	for (int j = 0; j < tree->dimensions; j++) {
+		int64_t min = (int64_t)cell[j] << shift;
+		int64_t max = min + ((int64_t)1 << shift) - 1;
+		if (max < v0[j] || min > v1[j]) {
+			return 0;
+		}
+		if (min < v0[j] || max > v1[j]) {
+			overlap = 1;
+		}
+	}
+	return overlap;
+}
+
+/* Writes to `result` the indices of the occupied cells from `v0` to `v1`
+included, in Morton order. At most `capacity` indices are written, the
+return value is the number of cells in the range */
+size_t linear_octree_query_range(struct linear_octree *tree, size_t *result, size_t capacity, mint_t *v0, mint_t *v1)
+{
+	struct linear_octree_node stack[LINEAR_OCTREE_STACK_SIZE];
+	struct linear_octree_node children[8];
+	size_t found = 0;
+	int top = 0;
+	if (tree->count == 0) {
+		return 0;
+	}
+	stack[top].key = 0;
+	stack[top].level = 0;
+	stack[top].first = 0;
+	stack[top].last = tree->count;
+	top++;
+	while (top > 0) {
+		struct linear_octree_node node = stack[--top];
+		int overlap = linear_octree_overlap(tree, &node, v0, v1);
+		if (overlap == 2) {
+			for (size_t i = node.first; i < node.last; i++) {
+				if (found < capacity) {
+					result[found] = i;
+				}
+				found++;
+			}
+		} else if (overlap == 1) {
+			/* Pushed in reverse, so the cells come out sorted */
+			for (int i = linear_octree_children(tree, children, &node); i > 0; i--) {
+				stack[top++] = children[i - 1];
+			}
+		}
+	}
+	return found;
+}
+
+/* Level of detail selection: descends from the root and writes to
+`result` the nodes (with their level in `levels`) that are cells or
+whose size is less than `error` times their distance from `v0`, in Morton
+order. At most `capacity` nodes are written, the return value is the
+number selected */
+size_t linear_octree_select_lod(struct linear_octree *tree, uint64_t *result, uint8_t *levels, size_t capacity, mfloat_t *v0, mfloat_t error)
+{
+	struct linear_octree_node stack[LINEAR_OCTREE_STACK_SIZE];
+	struct linear_octree_node children[8];
+	mint_t cell[VEC3_SIZE];
+	size_t found = 0;
+	int top = 0;
+	if (tree->count == 0) {
+		return 0;
+	}
+	stack[top].key = 0;
+	stack[top].level = 0;
+	stack[top].first = 0;
+	stack[top].last = tree->count;
+	top++;
+	while (top > 0) {
+		struct linear_octree_node node = stack[--top];
+		mfloat_t size = tree->cell_size * (mfloat_t)((uint64_t)1 << (tree->depth - node.level));
+		mfloat_t distance_squared = MFLOAT_C(0.0);
+		linear_octree_cell(tree, cell, node.key);
+		for (int j = 0; j < tree->dimensions; j++) {
+			mfloat_t d = tree->origin[j] + ((mfloat_t)cell[j] + MFLOAT_C(0.5)) * size - v0[j];
+			distance_squared = distance_squared + d * d;
+		}
+		if (node.level == tree->depth || size * size < error * error * distance_squared) {
+			if (found < capacity) {
+				result[found] = node.key;
+				levels[found] = (uint8_t)node.level;
+			}
+			found++;
+		} else {
+			for (int i = linear_octree_children(tree, children, &node); i > 0; i--) {
+				stack[top++] = children[i - 1];
+			}
+		}
+	}
+	return found;
+}
+#endif
+
+/* Gribb and Hartmann, for a clip volume with -w <= z <= w. With a
+projection to 0 <= z <= w the near plane is behind the real one, which
+is still conservative for culling */
+mfloat_t *frustum_from_mat4(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t planes[FRUSTUM_SIZE];
+	for (int i = 0; i < 4; i++) {
+		mfloat_t r1 = m0[i * 4];
+		mfloat_t r2 = m0[i * 4 + 1];
+		mfloat_t r3 = m0[i * 4 + 2];
+		mfloat_t r4 = m0[i * 4 + 3];
+		planes[i] = r4 + r1;
+		planes[4 + i] = r4 - r1;
+		planes[8 + i] = r4 + r2;
+		planes[12 + i] = r4 - r2;
+		planes[16 + i] = r4 + r3;
+		planes[20 + i] = r4 - r3;
+	}
+	for (int i = 0; i < FRUSTUM_SIZE; i += 4) {
+		mfloat_t l = MSQRT(planes[i] * planes[i] + planes[i + 1] * planes[i + 1] + planes[i + 2] * planes[i + 2]);
+		if (l > MFLOAT_C(0.0)) {
+			l = MFLOAT_C(1.0) / l;
+			result[i] = planes[i] * l;
+			result[i + 1] = planes[i + 1] * l;
+			result[i + 2] = planes[i + 2] * l;
+			result[i + 3] = planes[i + 3] * l;
+		} else {
+			/* The far plane of an infinite projection, nothing is outside */
+			result[i] = MFLOAT_C(0.0);
+			result[i + 1] = MFLOAT_C(0.0);
+			result[i + 2] = MFLOAT_C(0.0);
+			result[i + 3] = MFLOAT_C(1.0);
+		}
+	}
+	return result;
+}
+
+int frustum_classify_sphere(mfloat_t *f0, mfloat_t *v0, mfloat_t radius)
+{
+	int classification = FRUSTUM_INSIDE;
+	for (int i = 0; i < FRUSTUM_SIZE; i += 4) {
+		mfloat_t d = f0[i] * v0[0] + f0[i + 1] * v0[1] + f0[i + 2] * v0[2] + f0[i + 3];
+		if (d < -radius) {
+			return FRUSTUM_OUTSIDE;
+		}
+		if (d < radius) {
+			classification = FRUSTUM_INTERSECTING;
+		}
+	}
+	return classification;
+}
+
+int frustum_classify_aabb(mfloat_t *f0, mfloat_t *b0)
+{
+	int classification = FRUSTUM_INSIDE;
+	mfloat_t cx = (b0[0] + b0[3]) * MFLOAT_C(0.5);
+	mfloat_t cy = (b0[1] + b0[4]) * MFLOAT_C(0.5);
+	mfloat_t cz = (b0[2] + b0[5]) * MFLOAT_C(0.5);
+	mfloat_t ex = (b0[3] - b0[0]) * MFLOAT_C(0.5);
+	mfloat_t ey = (b0[4] - b0[1]) * MFLOAT_C(0.5);
+	mfloat_t ez = (b0[5] - b0[2]) * MFLOAT_C(0.5);
+	for (int i = 0; i < FRUSTUM_SIZE; i += 4) {
+		mfloat_t d = f0[i] * cx + f0[i + 1] * cy + f0[i + 2] * cz + f0[i + 3];
+		mfloat_t r = MFABS(f0[i]) * ex + MFABS(f0[i + 1]) * ey + MFABS(f0[i + 2]) * ez;
+		if (d < -r) {
+			return FRUSTUM_OUTSIDE;
+		}
+		if (d < r) {
+			classification = FRUSTUM_INTERSECTING;
+		}
+	}
+	return classification;
+}
+
+/* Classifies the elements from `first` to `count` and appends the visible
+ones to the `visible` indices already written */
+static size_t frustum_cull_spheres_range(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *s0, size_t first, size_t count, size_t visible)
+{
+	for (size_t i = first; i < count; i++) {
+		int classification_i = frustum_classify_sphere(f0, s0 + i * VEC4_SIZE, s0[i * VEC4_SIZE + 3]);
+		if (classification != NULL) {
+			classification[i] = (uint8_t)classification_i;
+		}
+		result[visible] = (uint32_t)i;
+		visible = visible + (classification_i != FRUSTUM_OUTSIDE);
+	}
+	return visible;
+}
+
+static size_t frustum_cull_aabbs_range(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *b0, size_t first, size_t count, size_t visible)
+{
+	for (size_t i = first; i < count; i++) {
+		int classification_i = frustum_classify_aabb(f0, b0 + i * AABB_SIZE);
+		if (classification != NULL) {
+			classification[i] = (uint8_t)classification_i;
+		}
+		result[visible] = (uint32_t)i;
+		visible = visible + (classification_i != FRUSTUM_OUTSIDE);
+	}
+	return visible;
+}
+
+static size_t frustum_cull_spheres_n_scalar(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *s0, size_t count)
+{
+	return frustum_cull_spheres_range(result, classification, f0, s0, 0, count, 0);
+}
+
+static size_t frustum_cull_aabbs_n_scalar(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *b0, size_t count)
+{
+	return frustum_cull_aabbs_range(result, classification, f0, b0, 0, count, 0);
+}
 
-mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up)
+#if defined(MATHC_SIMD_SSE2)
+/* Writes four classifications and appends the indices that aren't outside */
+static MATHC_TARGET_SSE2 size_t frustum_compact_sse2(uint32_t *result, uint8_t *classification, size_t first, size_t visible, __m128 outside, __m128 inside)
 {
-	mfloat_t tmp_forward[VEC3_SIZE];
-	mfloat_t tmp_side[VEC3_SIZE];
-	mfloat_t tmp_up[VEC3_SIZE];
-	vec3_subtract(tmp_forward, target, position);
-	vec3_normalize(tmp_forward, tmp_forward);
-	vec3_cross(tmp_side, tmp_forward, up);
-	vec3_normalize(tmp_side, tmp_side);
-	vec3_cross(tmp_up, tmp_side, tmp_forward);
-	result[0] = tmp_side[0];
-	result[1] = tmp_up[0];
-	result[2] = -tmp_forward[0];
-	result[3] = MFLOAT_C(0.0);
-	result[4] = tmp_side[1];
-	result[5] = tmp_up[1];
-	result[6] = -tmp_forward[1];
-	result[7] = MFLOAT_C(0.0);
-	result[8] = tmp_side[2];
-	result[9] = tmp_up[2];
-	result[10] = -tmp_forward[2];
-	result[11] = MFLOAT_C(0.0);
-	result[12] = -vec3_dot(tmp_side, position);
-	result[13] = -vec3_dot(tmp_up, position);
-	result[14] = vec3_dot(tmp_forward, position);
-	result[15] = MFLOAT_C(1.0);
-	return result;
+	int outside_mask = _mm_movemask_ps(outside);
+	int inside_mask = _mm_movemask_ps(inside);
+	for (int j = 0; j < 4; j++) {
+		int is_outside = (outside_mask >> j) & 1;
+		if (classification != NULL) {
+			classification[first + j] = (uint8_t)(is_outside ? FRUSTUM_OUTSIDE : ((inside_mask >> j) & 1) ? FRUSTUM_INSIDE : FRUSTUM_INTERSECTING);
+		}
+		result[visible] = (uint32_t)(first + j);
+		visible = visible + (size_t)(1 - is_outside);
+	}
+	return visible;
+}
+
+static MATHC_TARGET_SSE2 size_t frustum_cull_spheres_n_sse2(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *s0, size_t count)
+{
+	/* Four spheres per iteration, transposed to x, y, z and radius */
+	size_t visible = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x = _mm_loadu_ps(s0 + i * VEC4_SIZE);
+		__m128 y = _mm_loadu_ps(s0 + i * VEC4_SIZE + 4);
+		__m128 z = _mm_loadu_ps(s0 + i * VEC4_SIZE + 8);
+		__m128 r = _mm_loadu_ps(s0 + i * VEC4_SIZE + 12);
+		__m128 negative_r;
+		__m128 outside = _mm_setzero_ps();
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		_MM_TRANSPOSE4_PS(x, y, z, r);
+		negative_r = _mm_sub_ps(_mm_setzero_ps(), r);
+		for (int p = 0; p < FRUSTUM_SIZE; p += 4) {
+			__m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f0[p]), x), _mm_mul_ps(_mm_set1_ps(f0[p + 1]), y));
+			d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f0[p + 2]), z), _mm_set1_ps(f0[p + 3])));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negative_r));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(d, r));
+		}
+		visible = frustum_compact_sse2(result, classification, i, visible, outside, inside);
+	}
+	return frustum_cull_spheres_range(result, classification, f0, s0, i, count, visible);
+}
+
+static MATHC_TARGET_SSE2 size_t frustum_cull_aabbs_n_sse2(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *b0, size_t count)
+{
+	/* Four boxes per iteration, transposed to minimum and maximum x, y and
+	z, then tested as a center and extents */
+	size_t visible = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		mfloat_t *b = b0 + i * AABB_SIZE;
+		__m128 min_x = _mm_loadu_ps(b);
+		__m128 min_y = _mm_loadu_ps(b + AABB_SIZE);
+		__m128 min_z = _mm_loadu_ps(b + AABB_SIZE * 2);
+		__m128 max_x = _mm_loadu_ps(b + AABB_SIZE * 3);
+		__m128 t0 = _mm_loadu_ps(b + 2);
+		__m128 t1 = _mm_loadu_ps(b + AABB_SIZE + 2);
+		__m128 t2 = _mm_loadu_ps(b + AABB_SIZE * 2 + 2);
+		__m128 max_z = _mm_loadu_ps(b + AABB_SIZE * 3 + 2);
+		__m128 half = _mm_set1_ps(MFLOAT_C(0.5));
+		__m128 sign = _mm_set1_ps(-MFLOAT_C(0.0));
+		__m128 outside = _mm_setzero_ps();
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		__m128 cx;
+		__m128 cy;
+		__m128 cz;
+		__m128 ex;
+		__m128 ey;
+		__m128 ez;
+		_MM_TRANSPOSE4_PS(min_x, min_y, min_z, max_x);
+		/* The second loads start at the minimum z, so the third and fourth
+		rows are the maximum y and z */
+		_MM_TRANSPOSE4_PS(t0, t1, t2, max_z);
+		cx = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+		cy = _mm_mul_ps(_mm_add_ps(min_y, t2), half);
+		cz = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+		ex = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+		ey = _mm_mul_ps(_mm_sub_ps(t2, min_y), half);
+		ez = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+		for (int p = 0; p < FRUSTUM_SIZE; p += 4) {
+			__m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f0[p]), cx), _mm_mul_ps(_mm_set1_ps(f0[p + 1]), cy));
+			__m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(MFABS(f0[p])), ex), _mm_mul_ps(_mm_set1_ps(MFABS(f0[p + 1])), ey));
+			d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f0[p + 2]), cz), _mm_set1_ps(f0[p + 3])));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(MFABS(f0[p + 2])), ez));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(d, _mm_xor_ps(r, sign)));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(d, r));
+		}
+		visible = frustum_compact_sse2(result, classification, i, visible, outside, inside);
+	}
+	return frustum_cull_aabbs_range(result, classification, f0, b0, i, count, visible);
 }
+#endif
 
-mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f)
+/* `result` receives the indices of the elements that aren't outside and
+must have room for `count` indices. `classification` can be NULL */
+size_t frustum_cull_spheres_n(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *s0, size_t count)
 {
-	result[0] = MFLOAT_C(2.0) / (r - l);
-	result[1] = MFLOAT_C(0.0);
-	result[2] = MFLOAT_C(0.0);
-	result[3] = MFLOAT_C(0.0);
-	result[4] = MFLOAT_C(0.0);
-	result[5] = MFLOAT_C(2.0) / (t - b);
-	result[6] = MFLOAT_C(0.0);
-	result[7] = MFLOAT_C(0.0);
-	result[8] = MFLOAT_C(0.0);
-	result[9] = MFLOAT_C(0.0);
-	result[10] = -MFLOAT_C(2.0) / (f - n);
-	result[11] = MFLOAT_C(0.0);
-	result[12] = -((r + l) / (r - l));
-	result[13] = -((t + b) / (t - b));
-	result[14] = -((f + n) / (f - n));
-	result[15] = MFLOAT_C(1.0);
-	return result;
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->frustum_cull_spheres_n(result, classification, f0, s0, count);
+#else
+	return frustum_cull_spheres_n_scalar(result, classification, f0, s0, count);
+#endif
 }
 
-mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f)
+size_t frustum_cull_aabbs_n(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *b0, size_t count)
 {
-	mfloat_t tan_half_fov_y = MFLOAT_C(1.0) / MTAN(fov_y * MFLOAT_C(0.5));
-	result[0] = MFLOAT_C(1.0) / aspect * tan_half_fov_y;
-	result[1] = MFLOAT_C(0.0);
-	result[2] = MFLOAT_C(0.0);
-	result[3] = MFLOAT_C(0.0);
-	result[4] = MFLOAT_C(0.0);
-	result[5] = MFLOAT_C(1.0) / tan_half_fov_y;
-	result[6] = MFLOAT_C(0.0);
-	result[7] = MFLOAT_C(0.0);
-	result[8] = MFLOAT_C(0.0);
-	result[9] = MFLOAT_C(0.0);
-	result[10] = f / (n - f);
-	result[11] = -MFLOAT_C(1.0);
-	result[12] = MFLOAT_C(0.0);
-	result[13] = MFLOAT_C(0.0);
-	result[14] = -(f * n) / (f - n);
-	result[15] = MFLOAT_C(0.0);
-	return result;
+#if defined(MATHC_SIMD_SSE2)
+	return mathc_simd_kernels()->frustum_cull_aabbs_n(result, classification, f0, b0, count);
+#else
+	return frustum_cull_aabbs_n_scalar(result, classification, f0, b0, count);
+#endif
 }
 
-mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f)
+#if defined(MATHC_SIMD_SSE2)
+static const struct mathc_simd_kernels simd_kernels_scalar = {
+	fast_sin_n_scalar,
+	fast_cos_n_scalar,
+	fast_tan_n_scalar,
+	fast_acos_n_scalar,
+	fast_atan2_n_scalar,
+	fast_pow_n_scalar,
+	vec3_multiply_mat3_n_scalar,
+	vec3_rotate_quat_n_scalar,
+	vec4_multiply_mat4_scalar,
+	vec4_multiply_mat4_n_scalar,
+	quat_multiply_scalar,
+	quat_slerp_fast_n_scalar,
+	mat4_multiply_scalar,
+	mat4_inverse_scalar,
+	mat4_inverse_n_scalar,
+	mat4_skin_n_scalar,
+	mat3x4_skin_n_scalar,
+	frustum_cull_spheres_n_scalar,
+	frustum_cull_aabbs_n_scalar,
+	aabb_transform_n_scalar,
+	ray_intersect_triangles_n_scalar,
+	rays_intersect_triangle_n_scalar,
+	ray_intersect_aabbs_n_scalar
+};
+
+static const struct mathc_simd_kernels simd_kernels_sse2 = {
+	fast_sin_n_sse2,
+	fast_cos_n_sse2,
+	fast_tan_n_sse2,
+	fast_acos_n_sse2,
+	fast_atan2_n_sse2,
+	fast_pow_n_sse2,
+	vec3_multiply_mat3_n_sse2,
+	vec3_rotate_quat_n_sse2,
+	vec4_multiply_mat4_sse2,
+	vec4_multiply_mat4_n_sse2,
+	quat_multiply_sse2,
+	quat_slerp_fast_n_sse2,
+	mat4_multiply_sse2,
+	mat4_inverse_sse2,
+	mat4_inverse_n_sse2,
+	mat4_skin_n_sse2,
+	mat3x4_skin_n_sse2,
+	frustum_cull_spheres_n_sse2,
+	frustum_cull_aabbs_n_sse2,
+	aabb_transform_n_sse2,
+	ray_intersect_triangles_n_sse2,
+	rays_intersect_triangle_n_sse2,
+	ray_intersect_aabbs_n_sse2
+};
+
+#if defined(MATHC_SIMD_AVX2)
+static const struct mathc_simd_kernels simd_kernels_avx2 = {
+	fast_sin_n_avx2,
+	fast_cos_n_avx2,
+	fast_tan_n_avx2,
+	fast_acos_n_avx2,
+	fast_atan2_n_avx2,
+	fast_pow_n_avx2,
+	vec3_multiply_mat3_n_sse2,
+	vec3_rotate_quat_n_avx2,
+	vec4_multiply_mat4_sse2,
+	vec4_multiply_mat4_n_avx2,
+	quat_multiply_sse2,
+	quat_slerp_fast_n_avx2,
+	mat4_multiply_avx2,
+	mat4_inverse_sse2,
+	mat4_inverse_n_avx2,
+	mat4_skin_n_avx2,
+	mat3x4_skin_n_sse2,
+	frustum_cull_spheres_n_sse2,
+	frustum_cull_aabbs_n_sse2,
+	aabb_transform_n_sse2,
+	ray_intersect_triangles_n_avx2,
+	rays_intersect_triangle_n_avx2,
+	ray_intersect_aabbs_n_avx2
+};
+#endif
+
+#if defined(MATHC_SIMD_AVX512)
+static const struct mathc_simd_kernels simd_kernels_avx512 = {
+	fast_sin_n_avx2,
+	fast_cos_n_avx2,
+	fast_tan_n_avx2,
+	fast_acos_n_avx2,
+	fast_atan2_n_avx2,
+	fast_pow_n_avx2,
+	vec3_multiply_mat3_n_sse2,
+	vec3_rotate_quat_n_avx2,
+	vec4_multiply_mat4_sse2,
+	vec4_multiply_mat4_n_avx512,
+	quat_multiply_sse2,
+	quat_slerp_fast_n_avx2,
+	mat4_multiply_avx512,
+	mat4_inverse_sse2,
+	mat4_inverse_n_avx2,
+	mat4_skin_n_avx2,
+	mat3x4_skin_n_sse2,
+	frustum_cull_spheres_n_sse2,
+	frustum_cull_aabbs_n_sse2,
+	aabb_transform_n_sse2,
+	ray_intersect_triangles_n_avx2,
+	rays_intersect_triangle_n_avx2,
+	ray_intersect_aabbs_n_avx2
+};
+#endif
+
+static const struct mathc_simd_kernels *simd_kernels = NULL;
+static int simd_level = MATHC_SIMD_LEVEL_SCALAR;
+static int simd_supported_level = -1;
+
+/* Highest level that is both compiled in and supported by the CPU */
+static int mathc_simd_supported_level(void)
+{
+	if (simd_supported_level < 0) {
+		int level = MATHC_SIMD_LEVEL_SSE2;
+#if defined(MATHC_SIMD_DISPATCH) && defined(__GNUC__)
+		__builtin_cpu_init();
+#if defined(__i386__)
+		if (!__builtin_cpu_supports("sse2")) {
+			level = MATHC_SIMD_LEVEL_SCALAR;
+		} else
+#endif
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+			level = MATHC_SIMD_LEVEL_AVX2;
+			if (__builtin_cpu_supports("avx512f")) {
+				level = MATHC_SIMD_LEVEL_AVX512;
+			}
+		}
+#elif defined(MATHC_SIMD_DISPATCH) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] >= 7) {
+			bool fma;
+			bool osxsave;
+			__cpuid(info, 1);
+			fma = (info[2] & (1 << 12)) != 0;
+			osxsave = (info[2] & (1 << 27)) != 0;
+			if ((info[3] & (1 << 26)) == 0) {
+				level = MATHC_SIMD_LEVEL_SCALAR;
+			} else if (osxsave) {
+				unsigned long long xcr0 = _xgetbv(0);
+				__cpuidex(info, 7, 0);
+				if ((xcr0 & 0x6) == 0x6 && fma && (info[1] & (1 << 5)) != 0) {
+					level = MATHC_SIMD_LEVEL_AVX2;
+					if ((xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0) {
+						level = MATHC_SIMD_LEVEL_AVX512;
+					}
+				}
+			}
+		}
+#elif defined(MATHC_SIMD_AVX512)
+		level = MATHC_SIMD_LEVEL_AVX512;
+#elif defined(MATHC_SIMD_AVX2)
+		level = MATHC_SIMD_LEVEL_AVX2;
+#endif
+		simd_supported_level = level;
+	}
+	return simd_supported_level;
+}
+
+/* The kernels are chosen on first use without any synchronization, the
+level must be set with mathc_set_simd_level() before the library is used
+from several threads */
+static const struct mathc_simd_kernels *mathc_simd_kernels(void)
 {
-	mfloat_t h2 = MCOS(fov * MFLOAT_C(0.5)) / MSIN(fov * MFLOAT_C(0.5));
-	mfloat_t w2 = h2 * h / w;
-	result[0] = w2;
-	result[1] = MFLOAT_C(0.0);
-	result[2] = MFLOAT_C(0.0);
-	result[3] = MFLOAT_C(0.0);
-	result[4] = MFLOAT_C(0.0);
-	result[5] = h2;
-	result[6] = MFLOAT_C(0.0);
-	result[7] = MFLOAT_C(0.0);
-	result[8] = MFLOAT_C(0.0);
-	result[9] = MFLOAT_C(0.0);
-	result[10] = f / (n - f);
-	result[11] = -MFLOAT_C(1.0);
-	result[12] = MFLOAT_C(0.0);
-	result[13] = MFLOAT_C(0.0);
-	result[14] = -(f * n) / (f - n);
-	result[15] = MFLOAT_C(0.0);
-	return result;
+	if (simd_kernels == NULL) {
+		mathc_set_simd_level(MATHC_SIMD_LEVEL_AVX512);
+	}
+	return simd_kernels;
 }
+#endif
 
-mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n)
+int mathc_simd_level(void)
 {
-	mfloat_t range = MTAN(fov_y * MFLOAT_C(0.5)) * n;
-	mfloat_t left = -range * aspect;
-	mfloat_t right = range * aspect;
-	mfloat_t top = range;
-	mfloat_t bottom = -range;
-	result[0] = MFLOAT_C(2.0) * n / (right - left);
-	result[1] = MFLOAT_C(0.0);
-	result[2] = MFLOAT_C(0.0);
-	result[3] = MFLOAT_C(0.0);
-	result[4] = MFLOAT_C(0.0);
-	result[5] = MFLOAT_C(2.0) * n / (top - bottom);
-	result[6] = MFLOAT_C(0.0);
-	result[7] = MFLOAT_C(0.0);
-	result[8] = MFLOAT_C(0.0);
-	result[9] = MFLOAT_C(0.0);
-	result[10] = -MFLOAT_C(1.0);
-	result[11] = -MFLOAT_C(1.0);
-	result[12] = MFLOAT_C(0.0);
-	result[13] = MFLOAT_C(0.0);
-	result[14] = -MFLOAT_C(2.0) * n;
-	result[15] = MFLOAT_C(0.0);
-	return result;
+#if defined(MATHC_SIMD_SSE2)
+	mathc_simd_kernels();
+	return simd_level;
+#else
+	return MATHC_SIMD_LEVEL_SCALAR;
+#endif
+}
+
+int mathc_set_simd_level(int level)
+{
+#if defined(MATHC_SIMD_SSE2)
+	int supported = mathc_simd_supported_level();
+	if (level > supported) {
+		level = supported;
+	}
+	if (level <= MATHC_SIMD_LEVEL_SCALAR) {
+		level = MATHC_SIMD_LEVEL_SCALAR;
+		simd_kernels = &simd_kernels_scalar;
+#if defined(MATHC_SIMD_AVX512)
+	} else if (level >= MATHC_SIMD_LEVEL_AVX512) {
+		simd_kernels = &simd_kernels_avx512;
+#endif
+#if defined(MATHC_SIMD_AVX2)
+	} else if (level >= MATHC_SIMD_LEVEL_AVX2) {
+		simd_kernels = &simd_kernels_avx2;
+#endif
+	} else {
+		simd_kernels = &simd_kernels_sse2;
+	}
+	simd_level = level;
+	return level;
+#else
+	(void)level;
+	return MATHC_SIMD_LEVEL_SCALAR;
+#endif
 }
 #endif
 
@@ -3954,6 +9526,54 @@ struct vec4i svec4i_clamp(struct vec4i v0, struct vec4i v1, struct vec4i v2)
 	vec4i_clamp((mint_t *)&result, (mint_t *)&v0, (mint_t *)&v1, (mint_t *)&v2);
 	return result;
 }
+
+uint32_t svec2i_to_morton(struct vec2i v0)
+{
+	return vec2i_to_morton((mint_t *)&v0);
+}
+
+uint64_t svec2i_to_morton64(struct vec2i v0)
+{
+	return vec2i_to_morton64((mint_t *)&v0);
+}
+
+uint32_t svec3i_to_morton(struct vec3i v0)
+{
+	return vec3i_to_morton((mint_t *)&v0);
+}
+
+uint64_t svec3i_to_morton64(struct vec3i v0)
+{
+	return vec3i_to_morton64((mint_t *)&v0);
+}
+
+struct vec2i svec2i_from_morton(uint32_t code)
+{
+	struct vec2i result;
+	vec2i_from_morton((mint_t *)&result, code);
+	return result;
+}
+
+struct vec2i svec2i_from_morton64(uint64_t code)
+{
+	struct vec2i result;
+	vec2i_from_morton64((mint_t *)&result, code);
+	return result;
+}
+
+struct vec3i svec3i_from_morton(uint32_t code)
+{
+	struct vec3i result;
+	vec3i_from_morton((mint_t *)&result, code);
+	return result;
+}
+
+struct vec3i svec3i_from_morton64(uint64_t code)
+{
+	struct vec3i result;
+	vec3i_from_morton64((mint_t *)&result, code);
+	return result;
+}
 #endif
 
 #if defined(MATHC_USE_FLOATING_POINT)
@@ -4340,6 +9960,20 @@ struct vec3 svec3_multiply_mat3(struct vec3 v0, struct mat3 m0)
 	return result;
 }
 
+struct vec3 svec3_multiply_mat3x4(struct vec3 v0, struct mat3x4 m0)
+{
+	struct vec3 result;
+	vec3_multiply_mat3x4((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&m0);
+	return result;
+}
+
+struct vec3 svec3_multiply_mat3x4_direction(struct vec3 v0, struct mat3x4 m0)
+{
+	struct vec3 result;
+	vec3_multiply_mat3x4_direction((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&m0);
+	return result;
+}
+
 struct vec3 svec3_divide(struct vec3 v0, struct vec3 v1)
 {
 	struct vec3 result;
@@ -4467,7 +10101,14 @@ struct vec3 svec3_reflect(struct vec3 v0, struct vec3 normal)
 struct vec3 svec3_rotate(struct vec3 v0, struct vec3 ra, mfloat_t f)
 {
 	struct vec3 result;
-	vec3_lerp((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&ra, f);
+	vec3_rotate((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&ra, f);
+	return result;
+}
+
+struct vec3 svec3_rotate_quat(struct vec3 v0, struct quat q0)
+{
+	struct vec3 result;
+	vec3_rotate_quat((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&q0);
 	return result;
 }
 
@@ -4795,78 +10436,162 @@ struct quat squat_conjugate(struct quat q0)
 
 struct quat squat_inverse(struct quat q0)
 {
-	struct quat result;
-	quat_inverse((mfloat_t *)&result, (mfloat_t *)&q0);
-	return result;
+	struct quat result;
+	quat_inverse((mfloat_t *)&result, (mfloat_t *)&q0);
+	return result;
+}
+
+struct quat squat_normalize(struct quat q0)
+{
+	struct quat result;
+	quat_normalize((mfloat_t *)&result, (mfloat_t *)&q0);
+	return result;
+}
+
+mfloat_t squat_dot(struct quat q0, struct quat q1)
+{
+	return quat_dot((mfloat_t *)&q0, (mfloat_t *)&q1);
+}
+
+struct quat squat_power(struct quat q0, mfloat_t exponent)
+{
+	struct quat result;
+	quat_power((mfloat_t *)&result, (mfloat_t *)&q0, exponent);
+	return result;
+}
+
+struct quat squat_from_axis_angle(struct vec3 v0, mfloat_t angle)
+{
+	struct quat result;
+	quat_from_axis_angle((mfloat_t *)&result, (mfloat_t *)&v0, angle);
+	return result;
+}
+
+struct quat squat_from_vec3(struct vec3 v0, struct vec3 v1)
+{
+	struct quat result;
+	quat_from_vec3((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&v1);
+	return result;
+}
+
+struct quat squat_from_mat4(struct mat4 m0)
+{
+	struct quat result;
+	quat_from_mat4((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+struct quat squat_lerp(struct quat q0, struct quat q1, mfloat_t f)
+{
+	struct quat result;
+	quat_lerp((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&q1, f);
+	return result;
+}
+
+struct quat squat_slerp(struct quat q0, struct quat q1, mfloat_t f)
+{
+	struct quat result;
+	quat_slerp((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&q1, f);
+	return result;
+}
+
+struct quat squat_slerp_fast(struct quat q0, struct quat q1, mfloat_t f)
+{
+	struct quat result;
+	quat_slerp_fast((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&q1, f);
+	return result;
+}
+
+mfloat_t squat_length(struct quat q0)
+{
+	return quat_length((mfloat_t *)&q0);
+}
+
+mfloat_t squat_length_squared(struct quat q0)
+{
+	return quat_length_squared((mfloat_t *)&q0);
+}
+
+mfloat_t squat_angle(struct quat q0, struct quat q1)
+{
+	return quat_angle((mfloat_t *)&q0, (mfloat_t *)&q1);
 }
 
-struct quat squat_normalize(struct quat q0)
+struct dualquat sdualquat(struct quat q0, struct quat q1)
 {
-	struct quat result;
-	quat_normalize((mfloat_t *)&result, (mfloat_t *)&q0);
+	struct dualquat result;
+	dualquat((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&q1);
 	return result;
 }
 
-mfloat_t squat_dot(struct quat q0, struct quat q1)
+struct dualquat sdualquat_assign(struct dualquat d0)
 {
-	return quat_dot((mfloat_t *)&q0, (mfloat_t *)&q1);
+	struct dualquat result;
+	dualquat_assign((mfloat_t *)&result, (mfloat_t *)&d0);
+	return result;
 }
 
-struct quat squat_power(struct quat q0, mfloat_t exponent)
+struct dualquat sdualquat_null(void)
 {
-	struct quat result;
-	quat_power((mfloat_t *)&result, (mfloat_t *)&q0, exponent);
+	struct dualquat result;
+	dualquat_null((mfloat_t *)&result);
 	return result;
 }
 
-struct quat squat_from_axis_angle(struct vec3 v0, mfloat_t angle)
+struct dualquat sdualquat_from_rotation_translation(struct quat q0, struct vec3 v0)
 {
-	struct quat result;
-	quat_from_axis_angle((mfloat_t *)&result, (mfloat_t *)&v0, angle);
+	struct dualquat result;
+	dualquat_from_rotation_translation((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&v0);
 	return result;
 }
 
-struct quat squat_from_vec3(struct vec3 v0, struct vec3 v1)
+struct dualquat sdualquat_from_mat4(struct mat4 m0)
 {
-	struct quat result;
-	quat_from_vec3((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&v1);
+	struct dualquat result;
+	dualquat_from_mat4((mfloat_t *)&result, (mfloat_t *)&m0);
 	return result;
 }
 
-struct quat squat_from_mat4(struct mat4 m0)
+struct dualquat sdualquat_multiply(struct dualquat d0, struct dualquat d1)
 {
-	struct quat result;
-	quat_from_mat4((mfloat_t *)&result, (mfloat_t *)&m0);
+	struct dualquat result;
+	dualquat_multiply((mfloat_t *)&result, (mfloat_t *)&d0, (mfloat_t *)&d1);
 	return result;
 }
 
-struct quat squat_lerp(struct quat q0, struct quat q1, mfloat_t f)
+struct dualquat sdualquat_conjugate(struct dualquat d0)
 {
-	struct quat result;
-	quat_lerp((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&q1, f);
+	struct dualquat result;
+	dualquat_conjugate((mfloat_t *)&result, (mfloat_t *)&d0);
 	return result;
 }
 
-struct quat squat_slerp(struct quat q0, struct quat q1, mfloat_t f)
+struct dualquat sdualquat_normalize(struct dualquat d0)
 {
-	struct quat result;
-	quat_slerp((mfloat_t *)&result, (mfloat_t *)&q0, (mfloat_t *)&q1, f);
+	struct dualquat result;
+	dualquat_normalize((mfloat_t *)&result, (mfloat_t *)&d0);
 	return result;
 }
 
-mfloat_t squat_length(struct quat q0)
+struct vec3 sdualquat_translation(struct dualquat d0)
 {
-	return quat_length((mfloat_t *)&q0);
+	struct vec3 result;
+	dualquat_translation((mfloat_t *)&result, (mfloat_t *)&d0);
+	return result;
 }
 
-mfloat_t squat_length_squared(struct quat q0)
+struct dualquat sdualquat_sclerp(struct dualquat d0, struct dualquat d1, mfloat_t f)
 {
-	return quat_length_squared((mfloat_t *)&q0);
+	struct dualquat result;
+	dualquat_sclerp((mfloat_t *)&result, (mfloat_t *)&d0, (mfloat_t *)&d1, f);
+	return result;
 }
 
-mfloat_t squat_angle(struct quat q0, struct quat q1)
+struct mat4 smat4_from_dualquat(struct dualquat d0)
 {
-	return quat_angle((mfloat_t *)&q0, (mfloat_t *)&q1);
+	struct mat4 result;
+	mat4_from_dualquat((mfloat_t *)&result, (mfloat_t *)&d0);
+	return result;
 }
 
 struct mat2 smat2(mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22)
@@ -5054,6 +10779,13 @@ struct mat3 smat3_inverse(struct mat3 m0)
 	return result;
 }
 
+struct mat3 smat3_inverse_rigid(struct mat3 m0)
+{
+	struct mat3 result;
+	mat3_inverse_rigid((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
 struct mat3 smat3_scaling(struct vec3 v0)
 {
 	struct mat3 result;
@@ -5248,6 +10980,20 @@ struct mat4 smat4_inverse(struct mat4 m0)
 	return result;
 }
 
+struct mat4 smat4_inverse_affine(struct mat4 m0)
+{
+	struct mat4 result;
+	mat4_inverse_affine((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+struct mat4 smat4_inverse_rigid(struct mat4 m0)
+{
+	struct mat4 result;
+	mat4_inverse_rigid((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
 struct mat4 smat4_lerp(struct mat4 m0, struct mat4 m1, mfloat_t f)
 {
 	struct mat4 result;
@@ -5289,6 +11035,242 @@ struct mat4 smat4_perspective_infinite(mfloat_t fov_y, mfloat_t aspect, mfloat_t
 	mat4_perspective_infinite((mfloat_t *)&result, fov_y, aspect, n);
 	return result;
 }
+
+struct mat4 smat4_assign_mat3x4(struct mat3x4 m0)
+{
+	struct mat4 result;
+	mat4_assign_mat3x4((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+struct mat3x4 smat3x4(mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34)
+{
+	struct mat3x4 result;
+	mat3x4((mfloat_t *)&result, m11, m12, m13, m14, m21, m22, m23, m24, m31, m32, m33, m34);
+	return result;
+}
+
+struct mat3x4 smat3x4_zero(void)
+{
+	struct mat3x4 result;
+	mat3x4_zero((mfloat_t *)&result);
+	return result;
+}
+
+struct mat3x4 smat3x4_identity(void)
+{
+	struct mat3x4 result;
+	mat3x4_identity((mfloat_t *)&result);
+	return result;
+}
+
+struct mat3x4 smat3x4_assign(struct mat3x4 m0)
+{
+	struct mat3x4 result;
+	mat3x4_assign((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+struct mat3x4 smat3x4_assign_mat4(struct mat4 m0)
+{
+	struct mat3x4 result;
+	mat3x4_assign_mat4((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+struct mat3x4 smat3x4_multiply(struct mat3x4 m0, struct mat3x4 m1)
+{
+	struct mat3x4 result;
+	mat3x4_multiply((mfloat_t *)&result, (mfloat_t *)&m0, (mfloat_t *)&m1);
+	return result;
+}
+
+struct mat3x4 smat3x4_inverse(struct mat3x4 m0)
+{
+	struct mat3x4 result;
+	mat3x4_inverse((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+struct trs strs(struct vec3 v0, struct quat q0, struct vec3 v1)
+{
+	struct trs result;
+	trs((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&q0, (mfloat_t *)&v1);
+	return result;
+}
+
+struct trs strs_identity(void)
+{
+	struct trs result;
+	trs_identity((mfloat_t *)&result);
+	return result;
+}
+
+struct trs strs_assign(struct trs t0)
+{
+	struct trs result;
+	trs_assign((mfloat_t *)&result, (mfloat_t *)&t0);
+	return result;
+}
+
+struct trs strs_multiply(struct trs t0, struct trs t1)
+{
+	struct trs result;
+	trs_multiply((mfloat_t *)&result, (mfloat_t *)&t0, (mfloat_t *)&t1);
+	return result;
+}
+
+struct trs strs_inverse(struct trs t0)
+{
+	struct trs result;
+	trs_inverse((mfloat_t *)&result, (mfloat_t *)&t0);
+	return result;
+}
+
+struct trs strs_lerp(struct trs t0, struct trs t1, mfloat_t f)
+{
+	struct trs result;
+	trs_lerp((mfloat_t *)&result, (mfloat_t *)&t0, (mfloat_t *)&t1, f);
+	return result;
+}
+
+struct mat4 strs_to_mat4(struct trs t0)
+{
+	struct mat4 result;
+	trs_to_mat4((mfloat_t *)&result, (mfloat_t *)&t0);
+	return result;
+}
+
+struct mat3x4 strs_to_mat3x4(struct trs t0)
+{
+	struct mat3x4 result;
+	trs_to_mat3x4((mfloat_t *)&result, (mfloat_t *)&t0);
+	return result;
+}
+
+struct aabb saabb(struct vec3 v0, struct vec3 v1)
+{
+	struct aabb result;
+	aabb((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&v1);
+	return result;
+}
+
+struct aabb saabb_assign(struct aabb b0)
+{
+	struct aabb result;
+	aabb_assign((mfloat_t *)&result, (mfloat_t *)&b0);
+	return result;
+}
+
+struct vec3 saabb_center(struct aabb b0)
+{
+	struct vec3 result;
+	aabb_center((mfloat_t *)&result, (mfloat_t *)&b0);
+	return result;
+}
+
+struct vec3 saabb_extents(struct aabb b0)
+{
+	struct vec3 result;
+	aabb_extents((mfloat_t *)&result, (mfloat_t *)&b0);
+	return result;
+}
+
+struct aabb saabb_union(struct aabb b0, struct aabb b1)
+{
+	struct aabb result;
+	aabb_union((mfloat_t *)&result, (mfloat_t *)&b0, (mfloat_t *)&b1);
+	return result;
+}
+
+struct aabb saabb_intersection(struct aabb b0, struct aabb b1)
+{
+	struct aabb result;
+	aabb_intersection((mfloat_t *)&result, (mfloat_t *)&b0, (mfloat_t *)&b1);
+	return result;
+}
+
+bool saabb_is_empty(struct aabb b0)
+{
+	return aabb_is_empty((mfloat_t *)&b0);
+}
+
+bool saabb_intersects(struct aabb b0, struct aabb b1)
+{
+	return aabb_intersects((mfloat_t *)&b0, (mfloat_t *)&b1);
+}
+
+bool saabb_contains(struct aabb b0, struct aabb b1)
+{
+	return aabb_contains((mfloat_t *)&b0, (mfloat_t *)&b1);
+}
+
+bool saabb_contains_point(struct aabb b0, struct vec3 v0)
+{
+	return aabb_contains_point((mfloat_t *)&b0, (mfloat_t *)&v0);
+}
+
+struct aabb saabb_transform(struct aabb b0, struct mat4 m0)
+{
+	struct aabb result;
+	aabb_transform((mfloat_t *)&result, (mfloat_t *)&b0, (mfloat_t *)&m0);
+	return result;
+}
+
+struct ray sray(struct vec3 v0, struct vec3 v1)
+{
+	struct ray result;
+	ray((mfloat_t *)&result, (mfloat_t *)&v0, (mfloat_t *)&v1);
+	return result;
+}
+
+struct ray sray_assign(struct ray r0)
+{
+	struct ray result;
+	ray_assign((mfloat_t *)&result, (mfloat_t *)&r0);
+	return result;
+}
+
+struct vec3 sray_at(struct ray r0, mfloat_t t)
+{
+	struct vec3 result;
+	ray_at((mfloat_t *)&result, (mfloat_t *)&r0, t);
+	return result;
+}
+
+bool sray_intersect_triangle(struct vec3 *result, struct ray r0, struct vec3 v0, struct vec3 v1, struct vec3 v2)
+{
+	return ray_intersect_triangle((mfloat_t *)result, (mfloat_t *)&r0, (mfloat_t *)&v0, (mfloat_t *)&v1, (mfloat_t *)&v2);
+}
+
+struct ray sray_inverse_direction(struct ray r0)
+{
+	struct ray result;
+	ray_inverse_direction((mfloat_t *)&result, (mfloat_t *)&r0);
+	return result;
+}
+
+bool sray_intersect_aabb(mfloat_t *result, struct ray r0, struct aabb b0, mfloat_t t_max)
+{
+	return ray_intersect_aabb(result, (mfloat_t *)&r0, (mfloat_t *)&b0, t_max);
+}
+
+struct frustum sfrustum_from_mat4(struct mat4 m0)
+{
+	struct frustum result;
+	frustum_from_mat4((mfloat_t *)&result, (mfloat_t *)&m0);
+	return result;
+}
+
+int sfrustum_classify_sphere(struct frustum f0, struct vec3 v0, mfloat_t radius)
+{
+	return frustum_classify_sphere((mfloat_t *)&f0, (mfloat_t *)&v0, radius);
+}
+
+int sfrustum_classify_aabb(struct frustum f0, struct aabb b0)
+{
+	return frustum_classify_aabb((mfloat_t *)&f0, (mfloat_t *)&b0);
+}
 #endif
 #endif
 
@@ -5622,37 +11604,117 @@ struct vec4i *psvec4i_divide_i(struct vec4i *result, struct vec4i *v0, mint_t i)
 
 struct vec4i *psvec4i_snap(struct vec4i *result, struct vec4i *v0, struct vec4i *v1)
 {
-	return (struct vec4i *)vec4i_snap((mint_t *)result, (mint_t *)v0, (mint_t *)v1);
+	return (struct vec4i *)vec4i_snap((mint_t *)result, (mint_t *)v0, (mint_t *)v1);
+}
+
+struct vec4i *psvec4i_snap_i(struct vec4i *result, struct vec4i *v0, mint_t i)
+{
+	return (struct vec4i *)vec4i_snap_i((mint_t *)result, (mint_t *)v0, i);
+}
+
+struct vec4i *psvec4i_negative(struct vec4i *result, struct vec4i *v0)
+{
+	return (struct vec4i *)vec4i_negative((mint_t *)result, (mint_t *)v0);
+}
+
+struct vec4i *psvec4i_abs(struct vec4i *result, struct vec4i *v0)
+{
+	return (struct vec4i *)vec4i_abs((mint_t *)result, (mint_t *)v0);
+}
+
+struct vec4i *psvec4i_max(struct vec4i *result, struct vec4i *v0, struct vec4i *v1)
+{
+	return (struct vec4i *)vec4i_max((mint_t *)result, (mint_t *)v0, (mint_t *)v1);
+}
+
+struct vec4i *psvec4i_min(struct vec4i *result, struct vec4i *v0, struct vec4i *v1)
+{
+	return (struct vec4i *)vec4i_min((mint_t *)result, (mint_t *)v0, (mint_t *)v1);
+}
+
+struct vec4i *psvec4i_clamp(struct vec4i *result, struct vec4i *v0, struct vec4i *v1, struct vec4i *v2)
+{
+	return (struct vec4i *)vec4i_clamp((mint_t *)result, (mint_t *)v0, (mint_t *)v1, (mint_t *)v2);
+}
+
+uint32_t psvec2i_to_morton(struct vec2i *v0)
+{
+	return vec2i_to_morton((mint_t *)v0);
+}
+
+uint64_t psvec2i_to_morton64(struct vec2i *v0)
+{
+	return vec2i_to_morton64((mint_t *)v0);
+}
+
+uint32_t psvec3i_to_morton(struct vec3i *v0)
+{
+	return vec3i_to_morton((mint_t *)v0);
+}
+
+uint64_t psvec3i_to_morton64(struct vec3i *v0)
+{
+	return vec3i_to_morton64((mint_t *)v0);
+}
+
+struct vec2i *psvec2i_from_morton(struct vec2i *result, uint32_t code)
+{
+	return (struct vec2i *)vec2i_from_morton((mint_t *)result, code);
+}
+
+struct vec2i *psvec2i_from_morton64(struct vec2i *result, uint64_t code)
+{
+	return (struct vec2i *)vec2i_from_morton64((mint_t *)result, code);
+}
+
+struct vec3i *psvec3i_from_morton(struct vec3i *result, uint32_t code)
+{
+	return (struct vec3i *)vec3i_from_morton((mint_t *)result, code);
+}
+
+struct vec3i *psvec3i_from_morton64(struct vec3i *result, uint64_t code)
+{
+	return (struct vec3i *)vec3i_from_morton64((mint_t *)result, code);
+}
+
+uint32_t *psvec2i_to_morton_n(uint32_t *result, struct vec2i *v0, size_t count)
+{
+	return vec2i_to_morton_n(result, (mint_t *)v0, count);
+}
+
+uint64_t *psvec2i_to_morton64_n(uint64_t *result, struct vec2i *v0, size_t count)
+{
+	return vec2i_to_morton64_n(result, (mint_t *)v0, count);
 }
 
-struct vec4i *psvec4i_snap_i(struct vec4i *result, struct vec4i *v0, mint_t i)
+uint32_t *psvec3i_to_morton_n(uint32_t *result, struct vec3i *v0, size_t count)
 {
-	return (struct vec4i *)vec4i_snap_i((mint_t *)result, (mint_t *)v0, i);
+	return vec3i_to_morton_n(result, (mint_t *)v0, count);
 }
 
-struct vec4i *psvec4i_negative(struct vec4i *result, struct vec4i *v0)
+uint64_t *psvec3i_to_morton64_n(uint64_t *result, struct vec3i *v0, size_t count)
 {
-	return (struct vec4i *)vec4i_negative((mint_t *)result, (mint_t *)v0);
+	return vec3i_to_morton64_n(result, (mint_t *)v0, count);
 }
 
-struct vec4i *psvec4i_abs(struct vec4i *result, struct vec4i *v0)
+struct vec2i *psvec2i_from_morton_n(struct vec2i *result, uint32_t *c0, size_t count)
 {
-	return (struct vec4i *)vec4i_abs((mint_t *)result, (mint_t *)v0);
+	return (struct vec2i *)vec2i_from_morton_n((mint_t *)result, c0, count);
 }
 
-struct vec4i *psvec4i_max(struct vec4i *result, struct vec4i *v0, struct vec4i *v1)
+struct vec2i *psvec2i_from_morton64_n(struct vec2i *result, uint64_t *c0, size_t count)
 {
-	return (struct vec4i *)vec4i_max((mint_t *)result, (mint_t *)v0, (mint_t *)v1);
+	return (struct vec2i *)vec2i_from_morton64_n((mint_t *)result, c0, count);
 }
 
-struct vec4i *psvec4i_min(struct vec4i *result, struct vec4i *v0, struct vec4i *v1)
+struct vec3i *psvec3i_from_morton_n(struct vec3i *result, uint32_t *c0, size_t count)
 {
-	return (struct vec4i *)vec4i_min((mint_t *)result, (mint_t *)v0, (mint_t *)v1);
+	return (struct vec3i *)vec3i_from_morton_n((mint_t *)result, c0, count);
 }
 
-struct vec4i *psvec4i_clamp(struct vec4i *result, struct vec4i *v0, struct vec4i *v1, struct vec4i *v2)
+struct vec3i *psvec3i_from_morton64_n(struct vec3i *result, uint64_t *c0, size_t count)
 {
-	return (struct vec4i *)vec4i_clamp((mint_t *)result, (mint_t *)v0, (mint_t *)v1, (mint_t *)v2);
+	return (struct vec3i *)vec3i_from_morton64_n((mint_t *)result, c0, count);
 }
 #endif
 
@@ -5946,6 +12008,31 @@ struct vec3 *psvec3_multiply_mat3(struct vec3 *result, struct vec3 *v0, struct m
 	return (struct vec3 *)vec3_multiply_mat3((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0);
 }
 
+struct vec3 *psvec3_multiply_mat3_n(struct vec3 *result, struct vec3 *v0, struct mat3 *m0, size_t count)
+{
+	return (struct vec3 *)vec3_multiply_mat3_n((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0, count);
+}
+
+struct vec3 *psvec3_multiply_mat3x4(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0)
+{
+	return (struct vec3 *)vec3_multiply_mat3x4((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0);
+}
+
+struct vec3 *psvec3_multiply_mat3x4_n(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0, size_t count)
+{
+	return (struct vec3 *)vec3_multiply_mat3x4_n((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0, count);
+}
+
+struct vec3 *psvec3_multiply_mat3x4_direction(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0)
+{
+	return (struct vec3 *)vec3_multiply_mat3x4_direction((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0);
+}
+
+struct vec3 *psvec3_multiply_mat3x4_direction_n(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0, size_t count)
+{
+	return (struct vec3 *)vec3_multiply_mat3x4_direction_n((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0, count);
+}
+
 struct vec3 *psvec3_divide(struct vec3 *result, struct vec3 *v0, struct vec3 *v1)
 {
 	return (struct vec3 *)vec3_divide((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)v1);
@@ -6038,7 +12125,27 @@ struct vec3 *psvec3_reflect(struct vec3 *result, struct vec3 *v0, struct vec3 *n
 
 struct vec3 *psvec3_rotate(struct vec3 *result, struct vec3 *v0, struct vec3 *ra, mfloat_t f)
 {
-	return (struct vec3 *)vec3_lerp((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)ra, f);
+	return (struct vec3 *)vec3_rotate((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)ra, f);
+}
+
+struct vec3 *psvec3_rotate_n(struct vec3 *result, struct vec3 *v0, struct vec3 *ra, mfloat_t f, size_t count)
+{
+	return (struct vec3 *)vec3_rotate_n((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)ra, f, count);
+}
+
+struct vec3 *psvec3_rotate_quat(struct vec3 *result, struct vec3 *v0, struct quat *q0)
+{
+	return (struct vec3 *)vec3_rotate_quat((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)q0);
+}
+
+mfloat_t *psvec3_rotate_quat_n(mfloat_t *result, mfloat_t *v0, size_t stride, struct quat *q0, size_t count)
+{
+	return vec3_rotate_quat_n(result, v0, stride, (mfloat_t *)q0, count);
+}
+
+mfloat_t *psvec3_rotate_quats_n(mfloat_t *result, mfloat_t *v0, size_t stride, struct quat *q0, size_t count)
+{
+	return vec3_rotate_quats_n(result, v0, stride, (mfloat_t *)q0, count);
 }
 
 struct vec3 *psvec3_lerp(struct vec3 *result, struct vec3 *v0, struct vec3 *v1, mfloat_t f)
@@ -6153,6 +12260,11 @@ struct vec4 *psvec4_multiply_mat4(struct vec4 *result, struct vec4 *v0, struct m
 	return (struct vec4 *)vec4_multiply_mat4((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0);
 }
 
+struct vec4 *psvec4_multiply_mat4_n(struct vec4 *result, struct vec4 *v0, struct mat4 *m0, size_t count)
+{
+	return (struct vec4 *)vec4_multiply_mat4_n((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)m0, count);
+}
+
 struct vec4 *psvec4_divide(struct vec4 *result, struct vec4 *v0, struct vec4 *v1)
 {
 	return (struct vec4 *)vec4_divide((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)v1);
@@ -6328,6 +12440,16 @@ struct quat *psquat_slerp(struct quat *result, struct quat *q0, struct quat *q1,
 	return (struct quat *)quat_slerp((mfloat_t *)result, (mfloat_t *)q0, (mfloat_t *)q1, f);
 }
 
+struct quat *psquat_slerp_fast(struct quat *result, struct quat *q0, struct quat *q1, mfloat_t f)
+{
+	return (struct quat *)quat_slerp_fast((mfloat_t *)result, (mfloat_t *)q0, (mfloat_t *)q1, f);
+}
+
+struct quat *psquat_slerp_fast_n(struct quat *result, struct quat *q0, struct quat *q1, mfloat_t *f, size_t count)
+{
+	return (struct quat *)quat_slerp_fast_n((mfloat_t *)result, (mfloat_t *)q0, (mfloat_t *)q1, f, count);
+}
+
 mfloat_t psquat_length(struct quat *q0)
 {
 	return quat_length((mfloat_t *)q0);
@@ -6343,6 +12465,61 @@ mfloat_t psquat_angle(struct quat *q0, struct quat *q1)
 	return quat_angle((mfloat_t *)q0, (mfloat_t *)q1);
 }
 
+struct dualquat *psdualquat(struct dualquat *result, struct quat *q0, struct quat *q1)
+{
+	return (struct dualquat *)dualquat((mfloat_t *)result, (mfloat_t *)q0, (mfloat_t *)q1);
+}
+
+struct dualquat *psdualquat_assign(struct dualquat *result, struct dualquat *d0)
+{
+	return (struct dualquat *)dualquat_assign((mfloat_t *)result, (mfloat_t *)d0);
+}
+
+struct dualquat *psdualquat_null(struct dualquat *result)
+{
+	return (struct dualquat *)dualquat_null((mfloat_t *)result);
+}
+
+struct dualquat *psdualquat_from_rotation_translation(struct dualquat *result, struct quat *q0, struct vec3 *v0)
+{
+	return (struct dualquat *)dualquat_from_rotation_translation((mfloat_t *)result, (mfloat_t *)q0, (mfloat_t *)v0);
+}
+
+struct dualquat *psdualquat_from_mat4(struct dualquat *result, struct mat4 *m0)
+{
+	return (struct dualquat *)dualquat_from_mat4((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct dualquat *psdualquat_multiply(struct dualquat *result, struct dualquat *d0, struct dualquat *d1)
+{
+	return (struct dualquat *)dualquat_multiply((mfloat_t *)result, (mfloat_t *)d0, (mfloat_t *)d1);
+}
+
+struct dualquat *psdualquat_conjugate(struct dualquat *result, struct dualquat *d0)
+{
+	return (struct dualquat *)dualquat_conjugate((mfloat_t *)result, (mfloat_t *)d0);
+}
+
+struct dualquat *psdualquat_normalize(struct dualquat *result, struct dualquat *d0)
+{
+	return (struct dualquat *)dualquat_normalize((mfloat_t *)result, (mfloat_t *)d0);
+}
+
+struct vec3 *psdualquat_translation(struct vec3 *result, struct dualquat *d0)
+{
+	return (struct vec3 *)dualquat_translation((mfloat_t *)result, (mfloat_t *)d0);
+}
+
+struct dualquat *psdualquat_sclerp(struct dualquat *result, struct dualquat *d0, struct dualquat *d1, mfloat_t f)
+{
+	return (struct dualquat *)dualquat_sclerp((mfloat_t *)result, (mfloat_t *)d0, (mfloat_t *)d1, f);
+}
+
+struct mat4 *psmat4_from_dualquat(struct mat4 *result, struct dualquat *d0)
+{
+	return (struct mat4 *)mat4_from_dualquat((mfloat_t *)result, (mfloat_t *)d0);
+}
+
 struct mat2 *psmat2(struct mat2 *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22)
 {
 	return (struct mat2 *)mat2((mfloat_t *)result, m11, m12, m21, m22);
@@ -6478,6 +12655,16 @@ struct mat3 *psmat3_inverse(struct mat3 *result, struct mat3 *m0)
 	return (struct mat3 *)mat3_inverse((mfloat_t *)result, (mfloat_t *)m0);
 }
 
+struct mat3 *psmat3_inverse_rigid(struct mat3 *result, struct mat3 *m0)
+{
+	return (struct mat3 *)mat3_inverse_rigid((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat3 *psmat3_inverse_rigid_n(struct mat3 *result, struct mat3 *m0, size_t count)
+{
+	return (struct mat3 *)mat3_inverse_rigid_n((mfloat_t *)result, (mfloat_t *)m0, count);
+}
+
 struct mat3 *psmat3_scaling(struct mat3 *result, struct vec3 *v0)
 {
 	return (struct mat3 *)mat3_scaling((mfloat_t *)result, (mfloat_t *)v0);
@@ -6618,6 +12805,31 @@ struct mat4 *psmat4_inverse(struct mat4 *result, struct mat4 *m0)
 	return (struct mat4 *)mat4_inverse((mfloat_t *)result, (mfloat_t *)m0);
 }
 
+struct mat4 *psmat4_inverse_n(struct mat4 *result, struct mat4 *m0, size_t count)
+{
+	return (struct mat4 *)mat4_inverse_n((mfloat_t *)result, (mfloat_t *)m0, count);
+}
+
+struct mat4 *psmat4_inverse_affine(struct mat4 *result, struct mat4 *m0)
+{
+	return (struct mat4 *)mat4_inverse_affine((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat4 *psmat4_inverse_affine_n(struct mat4 *result, struct mat4 *m0, size_t count)
+{
+	return (struct mat4 *)mat4_inverse_affine_n((mfloat_t *)result, (mfloat_t *)m0, count);
+}
+
+struct mat4 *psmat4_inverse_rigid(struct mat4 *result, struct mat4 *m0)
+{
+	return (struct mat4 *)mat4_inverse_rigid((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat4 *psmat4_inverse_rigid_n(struct mat4 *result, struct mat4 *m0, size_t count)
+{
+	return (struct mat4 *)mat4_inverse_rigid_n((mfloat_t *)result, (mfloat_t *)m0, count);
+}
+
 struct mat4 *psmat4_lerp(struct mat4 *result, struct mat4 *m0, struct mat4 *m1, mfloat_t f)
 {
 	return (struct mat4 *)mat4_lerp((mfloat_t *)result, (mfloat_t *)m0, (mfloat_t *)m1, f);
@@ -6647,6 +12859,261 @@ struct mat4 *psmat4_perspective_infinite(struct mat4 *result, mfloat_t fov_y, mf
 {
 	return (struct mat4 *)mat4_perspective_infinite((mfloat_t *)result, fov_y, aspect, n);
 }
+
+struct mat4 *psmat4_assign_mat3x4(struct mat4 *result, struct mat3x4 *m0)
+{
+	return (struct mat4 *)mat4_assign_mat3x4((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat3x4 *psmat3x4(struct mat3x4 *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34)
+{
+	return (struct mat3x4 *)mat3x4((mfloat_t *)result, m11, m12, m13, m14, m21, m22, m23, m24, m31, m32, m33, m34);
+}
+
+struct mat3x4 *psmat3x4_zero(struct mat3x4 *result)
+{
+	return (struct mat3x4 *)mat3x4_zero((mfloat_t *)result);
+}
+
+struct mat3x4 *psmat3x4_identity(struct mat3x4 *result)
+{
+	return (struct mat3x4 *)mat3x4_identity((mfloat_t *)result);
+}
+
+struct mat3x4 *psmat3x4_assign(struct mat3x4 *result, struct mat3x4 *m0)
+{
+	return (struct mat3x4 *)mat3x4_assign((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat3x4 *psmat3x4_assign_mat4(struct mat3x4 *result, struct mat4 *m0)
+{
+	return (struct mat3x4 *)mat3x4_assign_mat4((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat3x4 *psmat3x4_multiply(struct mat3x4 *result, struct mat3x4 *m0, struct mat3x4 *m1)
+{
+	return (struct mat3x4 *)mat3x4_multiply((mfloat_t *)result, (mfloat_t *)m0, (mfloat_t *)m1);
+}
+
+struct mat3x4 *psmat3x4_multiply_n(struct mat3x4 *result, struct mat3x4 *m0, struct mat3x4 *m1, size_t count)
+{
+	return (struct mat3x4 *)mat3x4_multiply_n((mfloat_t *)result, (mfloat_t *)m0, (mfloat_t *)m1, count);
+}
+
+struct mat3x4 *psmat3x4_inverse(struct mat3x4 *result, struct mat3x4 *m0)
+{
+	return (struct mat3x4 *)mat3x4_inverse((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+struct mat3x4 *psmat3x4_inverse_n(struct mat3x4 *result, struct mat3x4 *m0, size_t count)
+{
+	return (struct mat3x4 *)mat3x4_inverse_n((mfloat_t *)result, (mfloat_t *)m0, count);
+}
+
+struct trs *pstrs(struct trs *result, struct vec3 *v0, struct quat *q0, struct vec3 *v1)
+{
+	return (struct trs *)trs((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)q0, (mfloat_t *)v1);
+}
+
+struct trs *pstrs_identity(struct trs *result)
+{
+	return (struct trs *)trs_identity((mfloat_t *)result);
+}
+
+struct trs *pstrs_assign(struct trs *result, struct trs *t0)
+{
+	return (struct trs *)trs_assign((mfloat_t *)result, (mfloat_t *)t0);
+}
+
+struct trs *pstrs_multiply(struct trs *result, struct trs *t0, struct trs *t1)
+{
+	return (struct trs *)trs_multiply((mfloat_t *)result, (mfloat_t *)t0, (mfloat_t *)t1);
+}
+
+struct trs *pstrs_inverse(struct trs *result, struct trs *t0)
+{
+	return (struct trs *)trs_inverse((mfloat_t *)result, (mfloat_t *)t0);
+}
+
+struct trs *pstrs_lerp(struct trs *result, struct trs *t0, struct trs *t1, mfloat_t f)
+{
+	return (struct trs *)trs_lerp((mfloat_t *)result, (mfloat_t *)t0, (mfloat_t *)t1, f);
+}
+
+struct trs *pstrs_lerp_n(struct trs *result, struct trs *t0, struct trs *t1, mfloat_t f, size_t count)
+{
+	return (struct trs *)trs_lerp_n((mfloat_t *)result, (mfloat_t *)t0, (mfloat_t *)t1, f, count);
+}
+
+struct mat4 *pstrs_to_mat4(struct mat4 *result, struct trs *t0)
+{
+	return (struct mat4 *)trs_to_mat4((mfloat_t *)result, (mfloat_t *)t0);
+}
+
+struct mat4 *pstrs_to_mat4_n(struct mat4 *result, struct trs *t0, size_t count)
+{
+	return (struct mat4 *)trs_to_mat4_n((mfloat_t *)result, (mfloat_t *)t0, count);
+}
+
+struct mat3x4 *pstrs_to_mat3x4(struct mat3x4 *result, struct trs *t0)
+{
+	return (struct mat3x4 *)trs_to_mat3x4((mfloat_t *)result, (mfloat_t *)t0);
+}
+
+struct mat3x4 *pstrs_to_mat3x4_n(struct mat3x4 *result, struct trs *t0, size_t count)
+{
+	return (struct mat3x4 *)trs_to_mat3x4_n((mfloat_t *)result, (mfloat_t *)t0, count);
+}
+
+void psdualquat_skin_n(struct vec3 *result_positions, struct vec3 *result_normals, struct vec3 *positions, struct vec3 *normals, uint16_t *indices, struct vec4 *weights, struct dualquat *palette, size_t count)
+{
+	dualquat_skin_n((mfloat_t *)result_positions, (mfloat_t *)result_normals, (mfloat_t *)positions, (mfloat_t *)normals, indices, (mfloat_t *)weights, (mfloat_t *)palette, count);
+}
+
+void psmat4_skin_n(struct vec3 *result_positions, struct vec3 *result_normals, struct vec3 *positions, struct vec3 *normals, uint16_t *indices, struct vec4 *weights, struct mat4 *palette, size_t count)
+{
+	mat4_skin_n((mfloat_t *)result_positions, (mfloat_t *)result_normals, (mfloat_t *)positions, (mfloat_t *)normals, indices, (mfloat_t *)weights, (mfloat_t *)palette, count);
+}
+
+void psmat3x4_skin_n(struct vec3 *result_positions, struct vec3 *result_normals, struct vec3 *positions, struct vec3 *normals, uint16_t *indices, struct vec4 *weights, struct mat3x4 *palette, size_t count)
+{
+	mat3x4_skin_n((mfloat_t *)result_positions, (mfloat_t *)result_normals, (mfloat_t *)positions, (mfloat_t *)normals, indices, (mfloat_t *)weights, (mfloat_t *)palette, count);
+}
+
+struct aabb *psaabb(struct aabb *result, struct vec3 *v0, struct vec3 *v1)
+{
+	return (struct aabb *)aabb((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)v1);
+}
+
+struct aabb *psaabb_assign(struct aabb *result, struct aabb *b0)
+{
+	return (struct aabb *)aabb_assign((mfloat_t *)result, (mfloat_t *)b0);
+}
+
+struct aabb *psaabb_from_points_n(struct aabb *result, struct vec3 *v0, size_t count)
+{
+	return (struct aabb *)aabb_from_points_n((mfloat_t *)result, (mfloat_t *)v0, count);
+}
+
+struct vec3 *psaabb_center(struct vec3 *result, struct aabb *b0)
+{
+	return (struct vec3 *)aabb_center((mfloat_t *)result, (mfloat_t *)b0);
+}
+
+struct vec3 *psaabb_extents(struct vec3 *result, struct aabb *b0)
+{
+	return (struct vec3 *)aabb_extents((mfloat_t *)result, (mfloat_t *)b0);
+}
+
+struct aabb *psaabb_union(struct aabb *result, struct aabb *b0, struct aabb *b1)
+{
+	return (struct aabb *)aabb_union((mfloat_t *)result, (mfloat_t *)b0, (mfloat_t *)b1);
+}
+
+struct aabb *psaabb_intersection(struct aabb *result, struct aabb *b0, struct aabb *b1)
+{
+	return (struct aabb *)aabb_intersection((mfloat_t *)result, (mfloat_t *)b0, (mfloat_t *)b1);
+}
+
+bool psaabb_is_empty(struct aabb *b0)
+{
+	return aabb_is_empty((mfloat_t *)b0);
+}
+
+bool psaabb_intersects(struct aabb *b0, struct aabb *b1)
+{
+	return aabb_intersects((mfloat_t *)b0, (mfloat_t *)b1);
+}
+
+bool psaabb_contains(struct aabb *b0, struct aabb *b1)
+{
+	return aabb_contains((mfloat_t *)b0, (mfloat_t *)b1);
+}
+
+bool psaabb_contains_point(struct aabb *b0, struct vec3 *v0)
+{
+	return aabb_contains_point((mfloat_t *)b0, (mfloat_t *)v0);
+}
+
+struct aabb *psaabb_transform(struct aabb *result, struct aabb *b0, struct mat4 *m0)
+{
+	return (struct aabb *)aabb_transform((mfloat_t *)result, (mfloat_t *)b0, (mfloat_t *)m0);
+}
+
+struct aabb *psaabb_transform_n(struct aabb *result, struct aabb *b0, struct mat4 *m0, size_t count)
+{
+	return (struct aabb *)aabb_transform_n((mfloat_t *)result, (mfloat_t *)b0, (mfloat_t *)m0, count);
+}
+
+struct ray *psray(struct ray *result, struct vec3 *v0, struct vec3 *v1)
+{
+	return (struct ray *)ray((mfloat_t *)result, (mfloat_t *)v0, (mfloat_t *)v1);
+}
+
+struct ray *psray_assign(struct ray *result, struct ray *r0)
+{
+	return (struct ray *)ray_assign((mfloat_t *)result, (mfloat_t *)r0);
+}
+
+struct vec3 *psray_at(struct vec3 *result, struct ray *r0, mfloat_t t)
+{
+	return (struct vec3 *)ray_at((mfloat_t *)result, (mfloat_t *)r0, t);
+}
+
+bool psray_intersect_triangle(struct vec3 *result, struct ray *r0, struct vec3 *v0, struct vec3 *v1, struct vec3 *v2)
+{
+	return ray_intersect_triangle((mfloat_t *)result, (mfloat_t *)r0, (mfloat_t *)v0, (mfloat_t *)v1, (mfloat_t *)v2);
+}
+
+size_t psray_intersect_triangles_n(struct vec3 *result, struct ray *r0, struct vec3 *t0, size_t count)
+{
+	return ray_intersect_triangles_n((mfloat_t *)result, (mfloat_t *)r0, (mfloat_t *)t0, count);
+}
+
+size_t psrays_intersect_triangle_n(struct vec3 *result, struct ray *r0, struct vec3 *v0, struct vec3 *v1, struct vec3 *v2, size_t count)
+{
+	return rays_intersect_triangle_n((mfloat_t *)result, (mfloat_t *)r0, (mfloat_t *)v0, (mfloat_t *)v1, (mfloat_t *)v2, count);
+}
+
+struct ray *psray_inverse_direction(struct ray *result, struct ray *r0)
+{
+	return (struct ray *)ray_inverse_direction((mfloat_t *)result, (mfloat_t *)r0);
+}
+
+bool psray_intersect_aabb(mfloat_t *result, struct ray *r0, struct aabb *b0, mfloat_t t_max)
+{
+	return ray_intersect_aabb(result, (mfloat_t *)r0, (mfloat_t *)b0, t_max);
+}
+
+size_t psray_intersect_aabbs_n(mfloat_t *result, uint32_t *mask, struct ray *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count)
+{
+	return ray_intersect_aabbs_n(result, mask, (mfloat_t *)r0, b0, stride, t_max, count);
+}
+
+struct frustum *psfrustum_from_mat4(struct frustum *result, struct mat4 *m0)
+{
+	return (struct frustum *)frustum_from_mat4((mfloat_t *)result, (mfloat_t *)m0);
+}
+
+int psfrustum_classify_sphere(struct frustum *f0, struct vec3 *v0, mfloat_t radius)
+{
+	return frustum_classify_sphere((mfloat_t *)f0, (mfloat_t *)v0, radius);
+}
+
+int psfrustum_classify_aabb(struct frustum *f0, struct aabb *b0)
+{
+	return frustum_classify_aabb((mfloat_t *)f0, (mfloat_t *)b0);
+}
+
+size_t psfrustum_cull_spheres_n(uint32_t *result, uint8_t *classification, struct frustum *f0, struct vec4 *s0, size_t count)
+{
+	return frustum_cull_spheres_n(result, classification, (mfloat_t *)f0, (mfloat_t *)s0, count);
+}
+
+size_t psfrustum_cull_aabbs_n(uint32_t *result, uint8_t *classification, struct frustum *f0, struct aabb *b0, size_t count)
+{
+	return frustum_cull_aabbs_n(result, classification, (mfloat_t *)f0, (mfloat_t *)b0, count);
+}
 #endif
 #endif
 
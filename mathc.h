@@ -22,6 +22,7 @@ the following restrictions:
 #define MATHC_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <math.h>
 
 #define MATHC_VERSION_YYYY 2019
@@ -44,8 +45,14 @@ the following restrictions:
 #if !defined(MATHC_NO_EASING_FUNCTIONS)
 #define MATHC_USE_EASING_FUNCTIONS
 #endif
+#if defined(MATHC_USE_AVX512) && !defined(MATHC_USE_AVX2)
+#define MATHC_USE_AVX2
+#endif
+#if defined(MATHC_USE_AVX2) && !defined(MATHC_USE_SSE2)
+#define MATHC_USE_SSE2
+#endif
 
-#if defined(MATHC_USE_INT)
+#if defined(MATHC_USE_INT) || defined(MATHC_USE_FLOATING_POINT)
 #include <stdint.h>
 #endif
 #if defined(MATHC_USE_FLOATING_POINT)
@@ -56,9 +63,24 @@ the following restrictions:
 #define VEC3_SIZE 3
 #define VEC4_SIZE 4
 #define QUAT_SIZE 4
+#define DUALQUAT_SIZE 8
 #define MAT2_SIZE 4
 #define MAT3_SIZE 9
 #define MAT4_SIZE 16
+#define MAT3X4_SIZE 12
+#define TRS_SIZE 10
+#define AABB_SIZE 6
+#define RAY_SIZE 6
+#define TRIANGLE_SIZE 9
+#define FRUSTUM_SIZE 24
+
+#define MATHC_SIMD_LEVEL_SCALAR 0
+#define MATHC_SIMD_LEVEL_SSE2 1
+#define MATHC_SIMD_LEVEL_AVX2 2
+#define MATHC_SIMD_LEVEL_AVX512 3
+#define FRUSTUM_OUTSIDE 0
+#define FRUSTUM_INTERSECTING 1
+#define FRUSTUM_INSIDE 2
 
 #if defined(MATHC_USE_INT)
 #if defined(MATHC_INT_TYPE)
@@ -112,17 +134,27 @@ typedef float mfloat_t;
 #define MPI_2 1.5707963268f
 #define MPI_4 0.7853981634f
 #define MFLT_EPSILON FLT_EPSILON
+#define MFLT_MAX FLT_MAX
 #define MFABS fabsf
 #define MFMIN fminf
 #define MFMAX fmaxf
 #define MSQRT sqrtf
+#if defined(MATHC_USE_FAST_TRIG)
+#define MSIN fast_sin
+#define MCOS fast_cos
+#define MACOS fast_acos
+#define MTAN fast_tan
+#define MATAN2 fast_atan2
+#define MPOW fast_pow
+#else
 #define MSIN sinf
 #define MCOS cosf
 #define MACOS acosf
-#define MASIN asinf
 #define MTAN tanf
 #define MATAN2 atan2f
 #define MPOW powf
+#endif
+#define MASIN asinf
 #define MFLOOR floorf
 #define MCEIL ceilf
 #define MROUND roundf
@@ -136,6 +168,7 @@ typedef double mfloat_t;
 #define MPI_2 1.57079632679489661923
 #define MPI_4 0.78539816339744830962
 #define MFLT_EPSILON DBL_EPSILON
+#define MFLT_MAX DBL_MAX
 #define MFABS fabs
 #define MFMIN fmin
 #define MFMAX fmax
@@ -279,6 +312,39 @@ struct quat {
 #endif
 };
 
+/*
+Dual quaternion representation, the real part holds the rotation and the
+dual part holds the translation:
+0/rx 1/ry 2/rz 3/rw
+4/dx 5/dy 6/dz 7/dw
+*/
+struct dualquat {
+#if defined(MATHC_USE_UNIONS)
+	union {
+		struct {
+			mfloat_t rx;
+			mfloat_t ry;
+			mfloat_t rz;
+			mfloat_t rw;
+			mfloat_t dx;
+			mfloat_t dy;
+			mfloat_t dz;
+			mfloat_t dw;
+		};
+		mfloat_t v[DUALQUAT_SIZE];
+	};
+#else
+	mfloat_t rx;
+	mfloat_t ry;
+	mfloat_t rz;
+	mfloat_t rw;
+	mfloat_t dx;
+	mfloat_t dy;
+	mfloat_t dz;
+	mfloat_t dw;
+#endif
+};
+
 /*
 Matrix 2×2 representation:
 0/m11 2/m12
@@ -387,6 +453,315 @@ struct mat4 {
 	mfloat_t m44;
 #endif
 };
+
+/*
+Matrix 3×4 representation, an affine transformation with the constant row
+0 0 0 1 of the 4×4 matrix omitted:
+0/m11 3/m12 6/m13  9/m14
+1/m21 4/m22 7/m23 10/m24
+2/m31 5/m32 8/m33 11/m34
+*/
+struct mat3x4 {
+#if defined(MATHC_USE_UNIONS)
+	union {
+		struct {
+			mfloat_t m11;
+			mfloat_t m21;
+			mfloat_t m31;
+			mfloat_t m12;
+			mfloat_t m22;
+			mfloat_t m32;
+			mfloat_t m13;
+			mfloat_t m23;
+			mfloat_t m33;
+			mfloat_t m14;
+			mfloat_t m24;
+			mfloat_t m34;
+		};
+		mfloat_t v[MAT3X4_SIZE];
+	};
+#else
+	mfloat_t m11;
+	mfloat_t m21;
+	mfloat_t m31;
+	mfloat_t m12;
+	mfloat_t m22;
+	mfloat_t m32;
+	mfloat_t m13;
+	mfloat_t m23;
+	mfloat_t m33;
+	mfloat_t m14;
+	mfloat_t m24;
+	mfloat_t m34;
+#endif
+};
+
+/*
+Translation, rotation and scale transformation, applied as scale first,
+then rotation, then translation:
+0/tx 1/ty 2/tz
+3/qx 4/qy 5/qz 6/qw
+7/sx 8/sy 9/sz
+*/
+struct trs {
+#if defined(MATHC_USE_UNIONS)
+	union {
+		struct {
+			mfloat_t tx;
+			mfloat_t ty;
+			mfloat_t tz;
+			mfloat_t qx;
+			mfloat_t qy;
+			mfloat_t qz;
+			mfloat_t qw;
+			mfloat_t sx;
+			mfloat_t sy;
+			mfloat_t sz;
+		};
+		mfloat_t v[TRS_SIZE];
+	};
+#else
+	mfloat_t tx;
+	mfloat_t ty;
+	mfloat_t tz;
+	mfloat_t qx;
+	mfloat_t qy;
+	mfloat_t qz;
+	mfloat_t qw;
+	mfloat_t sx;
+	mfloat_t sy;
+	mfloat_t sz;
+#endif
+};
+
+/*
+Axis-aligned bounding box representation, the minimum and the maximum
+corners:
+0/min.x 1/min.y 2/min.z
+3/max.x 4/max.y 5/max.z
+*/
+struct aabb {
+#if defined(MATHC_USE_UNIONS)
+	union {
+		struct {
+			struct vec3 min;
+			struct vec3 max;
+		};
+		mfloat_t v[AABB_SIZE];
+	};
+#else
+	struct vec3 min;
+	struct vec3 max;
+#endif
+};
+
+/*
+Ray representation, the origin and the direction:
+0/origin.x 1/origin.y 2/origin.z
+3/direction.x 4/direction.y 5/direction.z
+*/
+struct ray {
+#if defined(MATHC_USE_UNIONS)
+	union {
+		struct {
+			struct vec3 origin;
+			struct vec3 direction;
+		};
+		mfloat_t v[RAY_SIZE];
+	};
+#else
+	struct vec3 origin;
+	struct vec3 direction;
+#endif
+};
+
+/*
+Frustum representation, six planes `a * x + b * y + c * z + d = 0` with
+the normal pointing inside, in the order left, right, bottom, top, near
+and far:
+0/a 1/b 2/c 3/d
+*/
+struct frustum {
+#if defined(MATHC_USE_UNIONS)
+	union {
+		struct vec4 planes[6];
+		mfloat_t v[FRUSTUM_SIZE];
+	};
+#else
+	struct vec4 planes[6];
+#endif
+};
+#endif
+#endif
+
+#if defined(MATHC_USE_FLOATING_POINT)
+#define HIERARCHY_NO_PARENT ((size_t)-1)
+
+/*
+Transform hierarchy stored as parallel arrays owned by the caller. Nodes
+must be sorted by depth, so every parent comes before its children and
+each depth level is a contiguous range:
+parent    count indices, HIERARCHY_NO_PARENT for the roots
+position  count * VEC3_SIZE
+rotation  count * QUAT_SIZE
+scale     count * VEC3_SIZE
+world     count * MAT4_SIZE
+dirty     count flags
+levels    up to count + 1 offsets, filled by hierarchy_build_levels()
+*/
+struct hierarchy {
+	size_t count;
+	size_t *parent;
+	mfloat_t *position;
+	mfloat_t *rotation;
+	mfloat_t *scale;
+	mfloat_t *world;
+	bool *dirty;
+	size_t *levels;
+	size_t level_count;
+};
+
+/*
+Transform builder, the operations are applied in the order they are
+recorded, as if each one was multiplied on the right of the previous
+result. Rotations and scalings are kept pending as a quaternion and a
+diagonal and are only multiplied into `matrix` when an operation can't
+be folded into them:
+matrix    = matrix * rotation * scaling
+*/
+struct transform_builder {
+	mfloat_t matrix[MAT3X4_SIZE];
+	mfloat_t rotation[QUAT_SIZE];
+	mfloat_t scaling[VEC3_SIZE];
+};
+
+/*
+Slerp stepper, samples the slerp between two quaternions at evenly spaced
+factors with one quaternion multiplication per sample. Every few steps
+`current` is computed again with quat_slerp() from `q0` and `q1`, so the
+error doesn't grow with the number of steps:
+current   = q0 * delta^step
+delta     = (conjugate(q0) * q1)^(1 / steps)
+*/
+struct slerp_stepper {
+	mfloat_t current[QUAT_SIZE];
+	mfloat_t delta[QUAT_SIZE];
+	mfloat_t q0[QUAT_SIZE];
+	mfloat_t q1[QUAT_SIZE];
+	size_t step;
+	size_t steps;
+};
+
+#define BVH_LEAF_SIZE 4
+#define BVH_BINS 16
+#define BVH_MAX_DEPTH 64
+
+/*
+Bounding volume hierarchy node. Inner nodes have a `count` of zero and
+their two children are the consecutive nodes starting at `first`. Leaves
+hold the primitives `indices[first]` to `indices[first + count - 1]`
+*/
+struct bvh_node {
+	mfloat_t bounds[AABB_SIZE];
+	uint32_t first;
+	uint32_t count;
+};
+
+/*
+Bounding volume hierarchy stored in arrays owned by the caller, built
+over `count` primitive boxes with a binned surface area heuristic. The root
+is the node 0 and the two children of a node are next to each other, the
+smaller one is filled first so the order is not a plain depth first one.
+bvh_build() runs on the calling thread, the library doesn't use threads:
+nodes     up to 2 * count - 1 nodes
+indices   count primitive indices, reordered by bvh_build()
+*/
+struct bvh {
+	size_t count;
+	struct bvh_node *nodes;
+	uint32_t *indices;
+	size_t node_count;
+};
+
+#define AABB_TREE_NULL ((uint32_t)-1)
+#define AABB_TREE_MAX_HEIGHT 64
+
+/*
+Dynamic AABB tree node. Leaves have a `height` of zero and the fattened
+bounds of one object, free nodes have a `height` of -1 and `parent` is
+the next free node
+*/
+struct aabb_tree_node {
+	mfloat_t bounds[AABB_SIZE];
+	uint32_t parent;
+	uint32_t left;
+	uint32_t right;
+	int32_t height;
+};
+
+/*
+Dynamic AABB tree over a pool of `capacity` nodes owned by the caller,
+`count` objects need 2 * count - 1 nodes. Leaves are fattened by `margin`
+on each side, so objects moving inside their leaf don't change the tree
+*/
+struct aabb_tree {
+	struct aabb_tree_node *nodes;
+	size_t capacity;
+	size_t node_count;
+	uint32_t root;
+	uint32_t free;
+	mfloat_t margin;
+};
+
+#if defined(MATHC_USE_INT)
+/*
+Spatial hash grid over points or spheres stored as arrays owned by the
+caller. Cells are cubes of `cell_size` keyed by their vec3i coordinates,
+hashed into `bucket_count` buckets (a power of two). The entries of the
+bucket `i` are the point indices from `buckets[i]` to `buckets[i + 1]`:
+buckets   bucket_count + 1 offsets
+entries   count point indices, sorted by bucket
+keys      count buckets, one for each point
+The positions and the optional radii are the arrays given to
+spatial_hash_build(), which also fills the remaining members
+*/
+struct spatial_hash {
+	mfloat_t cell_size;
+	size_t bucket_count;
+	uint32_t *buckets;
+	uint32_t *entries;
+	uint32_t *keys;
+	size_t count;
+	mfloat_t *x;
+	mfloat_t *y;
+	mfloat_t *z;
+	mfloat_t *radius;
+	mfloat_t max_radius;
+	mint_t min[VEC3_SIZE];
+	mint_t max[VEC3_SIZE];
+};
+
+#define LINEAR_OCTREE_MAX_DEPTH 21
+#define LINEAR_QUADTREE_MAX_DEPTH 31
+
+/*
+Linear octree, or quadtree when `dimensions` is 2, stored as the sorted
+64-bit Morton codes of its occupied cells at the finest level. A node at
+`level` (0 for the root, `depth` for the cells) is the code of its vec3i
+or vec2i coordinates in the grid of that level, its cells are the range
+of `keys` starting with that code. The cells are cubes of `cell_size`
+from `origin`, `depth` is at most LINEAR_OCTREE_MAX_DEPTH or
+LINEAR_QUADTREE_MAX_DEPTH:
+keys      count codes, filled by linear_octree_build()
+*/
+struct linear_octree {
+	int dimensions;
+	int depth;
+	mfloat_t origin[VEC3_SIZE];
+	mfloat_t cell_size;
+	uint64_t *keys;
+	size_t count;
+};
 #endif
 #endif
 
@@ -401,6 +776,22 @@ bool nearly_equal(mfloat_t a, mfloat_t b, mfloat_t epsilon);
 mfloat_t to_radians(mfloat_t degrees);
 mfloat_t to_degrees(mfloat_t radians);
 mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max);
+int mathc_simd_level(void);
+int mathc_set_simd_level(int level);
+#if defined(MATHC_USE_SINGLE_FLOATING_POINT)
+mfloat_t fast_sin(mfloat_t f);
+mfloat_t fast_cos(mfloat_t f);
+mfloat_t fast_tan(mfloat_t f);
+mfloat_t fast_acos(mfloat_t f);
+mfloat_t fast_atan2(mfloat_t y, mfloat_t x);
+mfloat_t fast_pow(mfloat_t x, mfloat_t y);
+mfloat_t *fast_sin_n(mfloat_t *result, mfloat_t *v0, size_t count);
+mfloat_t *fast_cos_n(mfloat_t *result, mfloat_t *v0, size_t count);
+mfloat_t *fast_tan_n(mfloat_t *result, mfloat_t *v0, size_t count);
+mfloat_t *fast_acos_n(mfloat_t *result, mfloat_t *v0, size_t count);
+mfloat_t *fast_atan2_n(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count);
+mfloat_t *fast_pow_n(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, size_t count);
+#endif
 #endif
 
 #if defined(MATHC_USE_INT)
@@ -481,6 +872,27 @@ mint_t *vec4i_abs(mint_t *result, mint_t *v0);
 mint_t *vec4i_max(mint_t *result, mint_t *v0, mint_t *v1);
 mint_t *vec4i_min(mint_t *result, mint_t *v0, mint_t *v1);
 mint_t *vec4i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
+uint32_t vec2i_to_morton(mint_t *v0);
+uint64_t vec2i_to_morton64(mint_t *v0);
+uint32_t vec3i_to_morton(mint_t *v0);
+uint64_t vec3i_to_morton64(mint_t *v0);
+mint_t *vec2i_from_morton(mint_t *result, uint32_t code);
+mint_t *vec2i_from_morton64(mint_t *result, uint64_t code);
+mint_t *vec3i_from_morton(mint_t *result, uint32_t code);
+mint_t *vec3i_from_morton64(mint_t *result, uint64_t code);
+uint32_t *vec2i_to_morton_n(uint32_t *result, mint_t *v0, size_t count);
+uint64_t *vec2i_to_morton64_n(uint64_t *result, mint_t *v0, size_t count);
+uint32_t *vec3i_to_morton_n(uint32_t *result, mint_t *v0, size_t count);
+uint64_t *vec3i_to_morton64_n(uint64_t *result, mint_t *v0, size_t count);
+mint_t *vec2i_from_morton_n(mint_t *result, uint32_t *c0, size_t count);
+mint_t *vec2i_from_morton64_n(mint_t *result, uint64_t *c0, size_t count);
+mint_t *vec3i_from_morton_n(mint_t *result, uint32_t *c0, size_t count);
+mint_t *vec3i_from_morton64_n(mint_t *result, uint64_t *c0, size_t count);
+void morton_sort_n(uint32_t *codes, uint32_t *indices, uint32_t *codes_scratch, uint32_t *indices_scratch, size_t count);
+void morton64_sort_n(uint64_t *codes, uint32_t *indices, uint64_t *codes_scratch, uint32_t *indices_scratch, size_t count);
+#if defined(MATHC_USE_FLOATING_POINT)
+mfloat_t *morton_reorder_n(mfloat_t *result, mfloat_t *v0, uint32_t *indices, size_t count);
+#endif
 #endif
 #if defined(MATHC_USE_FLOATING_POINT)
 bool vec2_is_zero(mfloat_t *v0);
@@ -546,6 +958,11 @@ mfloat_t *vec3_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
 mfloat_t *vec3_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
 mfloat_t *vec3_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
 mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+mfloat_t *vec3_multiply_mat3_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count);
+mfloat_t *vec3_multiply_mat3x4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+mfloat_t *vec3_multiply_mat3x4_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count);
+mfloat_t *vec3_multiply_mat3x4_direction(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+mfloat_t *vec3_multiply_mat3x4_direction_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count);
 mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
 mfloat_t *vec3_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
 mfloat_t *vec3_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
@@ -565,6 +982,10 @@ mfloat_t *vec3_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
 mfloat_t *vec3_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
 mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
 mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f);
+mfloat_t *vec3_rotate_n(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f, size_t count);
+mfloat_t *vec3_rotate_quat(mfloat_t *result, mfloat_t *v0, mfloat_t *q0);
+mfloat_t *vec3_rotate_quat_n(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t count);
+mfloat_t *vec3_rotate_quats_n(mfloat_t *result, mfloat_t *v0, size_t stride, mfloat_t *q0, size_t count);
 mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
 mfloat_t *vec3_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f);
 mfloat_t *vec3_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f);
@@ -591,6 +1012,7 @@ mfloat_t *vec4_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
 mfloat_t *vec4_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
 mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
 mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+mfloat_t *vec4_multiply_mat4_n(mfloat_t *result, mfloat_t *v0, mfloat_t *m0, size_t count);
 mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
 mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
 mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
@@ -626,9 +1048,22 @@ mfloat_t *quat_from_vec3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
 mfloat_t *quat_from_mat4(mfloat_t *result, mfloat_t *m0);
 mfloat_t *quat_lerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
 mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
+mfloat_t *quat_slerp_fast(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
+mfloat_t *quat_slerp_fast_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t *f, size_t count);
 mfloat_t quat_length(mfloat_t *q0);
 mfloat_t quat_length_squared(mfloat_t *q0);
 mfloat_t quat_angle(mfloat_t *q0, mfloat_t *q1);
+mfloat_t *dualquat(mfloat_t *result, mfloat_t *q0, mfloat_t *q1);
+mfloat_t *dualquat_assign(mfloat_t *result, mfloat_t *d0);
+mfloat_t *dualquat_null(mfloat_t *result);
+mfloat_t *dualquat_from_rotation_translation(mfloat_t *result, mfloat_t *q0, mfloat_t *v0);
+mfloat_t *dualquat_from_mat4(mfloat_t *result, mfloat_t *m0);
+mfloat_t *dualquat_multiply(mfloat_t *result, mfloat_t *d0, mfloat_t *d1);
+mfloat_t *dualquat_conjugate(mfloat_t *result, mfloat_t *d0);
+mfloat_t *dualquat_normalize(mfloat_t *result, mfloat_t *d0);
+mfloat_t *dualquat_translation(mfloat_t *result, mfloat_t *d0);
+mfloat_t *dualquat_sclerp(mfloat_t *result, mfloat_t *d0, mfloat_t *d1, mfloat_t f);
+mfloat_t *mat4_from_dualquat(mfloat_t *result, mfloat_t *d0);
 mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22);
 mfloat_t *mat2_zero(mfloat_t *result);
 mfloat_t *mat2_identity(mfloat_t *result);
@@ -656,6 +1091,8 @@ mfloat_t *mat3_cofactor(mfloat_t *result, mfloat_t *m0);
 mfloat_t *mat3_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
 mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
 mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat3_inverse_rigid(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat3_inverse_rigid_n(mfloat_t *result, mfloat_t *m0, size_t count);
 mfloat_t *mat3_scaling(mfloat_t *result, mfloat_t *v0);
 mfloat_t *mat3_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
 mfloat_t *mat3_rotation_x(mfloat_t *result, mfloat_t f);
@@ -684,12 +1121,111 @@ mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
 mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
 mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
 mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat4_inverse_n(mfloat_t *result, mfloat_t *m0, size_t count);
+mfloat_t *mat4_inverse_affine(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat4_inverse_affine_n(mfloat_t *result, mfloat_t *m0, size_t count);
+mfloat_t *mat4_inverse_rigid(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat4_inverse_rigid_n(mfloat_t *result, mfloat_t *m0, size_t count);
 mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
 mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up);
 mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f);
 mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f);
 mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f);
 mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n);
+mfloat_t *mat4_assign_mat3x4(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat3x4(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34);
+mfloat_t *mat3x4_zero(mfloat_t *result);
+mfloat_t *mat3x4_identity(mfloat_t *result);
+mfloat_t *mat3x4_assign(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat3x4_assign_mat4(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat3x4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
+mfloat_t *mat3x4_multiply_n(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count);
+mfloat_t *mat3x4_inverse(mfloat_t *result, mfloat_t *m0);
+mfloat_t *mat3x4_inverse_n(mfloat_t *result, mfloat_t *m0, size_t count);
+mfloat_t *trs(mfloat_t *result, mfloat_t *v0, mfloat_t *q0, mfloat_t *v1);
+mfloat_t *trs_identity(mfloat_t *result);
+mfloat_t *trs_assign(mfloat_t *result, mfloat_t *t0);
+mfloat_t *trs_multiply(mfloat_t *result, mfloat_t *t0, mfloat_t *t1);
+mfloat_t *trs_inverse(mfloat_t *result, mfloat_t *t0);
+mfloat_t *trs_lerp(mfloat_t *result, mfloat_t *t0, mfloat_t *t1, mfloat_t f);
+mfloat_t *trs_lerp_n(mfloat_t *result, mfloat_t *t0, mfloat_t *t1, mfloat_t f, size_t count);
+mfloat_t *trs_to_mat4(mfloat_t *result, mfloat_t *t0);
+mfloat_t *trs_to_mat4_n(mfloat_t *result, mfloat_t *t0, size_t count);
+mfloat_t *trs_to_mat3x4(mfloat_t *result, mfloat_t *t0);
+mfloat_t *trs_to_mat3x4_n(mfloat_t *result, mfloat_t *t0, size_t count);
+bool hierarchy_build_levels(struct hierarchy *hierarchy);
+void hierarchy_set_dirty(struct hierarchy *hierarchy, size_t index);
+void hierarchy_update_range(struct hierarchy *hierarchy, size_t first, size_t last);
+void hierarchy_clear_dirty(struct hierarchy *hierarchy);
+void hierarchy_update(struct hierarchy *hierarchy);
+void dualquat_skin_n(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count);
+void mat4_skin_n(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count);
+void mat3x4_skin_n(mfloat_t *result_positions, mfloat_t *result_normals, mfloat_t *positions, mfloat_t *normals, uint16_t *indices, mfloat_t *weights, mfloat_t *palette, size_t count);
+mfloat_t *aabb(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+mfloat_t *aabb_assign(mfloat_t *result, mfloat_t *b0);
+mfloat_t *aabb_from_points_n(mfloat_t *result, mfloat_t *v0, size_t count);
+mfloat_t *aabb_center(mfloat_t *result, mfloat_t *b0);
+mfloat_t *aabb_extents(mfloat_t *result, mfloat_t *b0);
+mfloat_t *aabb_union(mfloat_t *result, mfloat_t *b0, mfloat_t *b1);
+mfloat_t *aabb_intersection(mfloat_t *result, mfloat_t *b0, mfloat_t *b1);
+bool aabb_is_empty(mfloat_t *b0);
+bool aabb_intersects(mfloat_t *b0, mfloat_t *b1);
+bool aabb_contains(mfloat_t *b0, mfloat_t *b1);
+bool aabb_contains_point(mfloat_t *b0, mfloat_t *v0);
+mfloat_t *aabb_transform(mfloat_t *result, mfloat_t *b0, mfloat_t *m0);
+mfloat_t *aabb_transform_n(mfloat_t *result, mfloat_t *b0, mfloat_t *m0, size_t count);
+mfloat_t *ray(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+mfloat_t *ray_assign(mfloat_t *result, mfloat_t *r0);
+mfloat_t *ray_at(mfloat_t *result, mfloat_t *r0, mfloat_t t);
+bool ray_intersect_triangle(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+size_t ray_intersect_triangles_n(mfloat_t *result, mfloat_t *r0, mfloat_t *t0, size_t count);
+size_t rays_intersect_triangle_n(mfloat_t *result, mfloat_t *r0, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count);
+mfloat_t *ray_inverse_direction(mfloat_t *result, mfloat_t *r0);
+bool ray_intersect_aabb(mfloat_t *result, mfloat_t *r0, mfloat_t *b0, mfloat_t t_max);
+size_t ray_intersect_aabbs_n(mfloat_t *result, uint32_t *mask, mfloat_t *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count);
+void bvh_build(struct bvh *bvh, mfloat_t *b0);
+size_t bvh_intersect_triangles(struct bvh *bvh, mfloat_t *result, mfloat_t *r0, mfloat_t *t0, mfloat_t t_max);
+bool bvh_occluded_triangles(struct bvh *bvh, mfloat_t *r0, mfloat_t *t0, mfloat_t t_max);
+size_t bvh_overlap_aabb(struct bvh *bvh, uint32_t *result, size_t capacity, mfloat_t *b0, mfloat_t *b1);
+void aabb_tree_init(struct aabb_tree *tree, struct aabb_tree_node *nodes, size_t capacity, mfloat_t margin);
+uint32_t aabb_tree_insert(struct aabb_tree *tree, mfloat_t *b0);
+void aabb_tree_remove(struct aabb_tree *tree, uint32_t leaf);
+bool aabb_tree_move(struct aabb_tree *tree, uint32_t leaf, mfloat_t *b0);
+size_t aabb_tree_overlap_aabb(struct aabb_tree *tree, uint32_t *result, size_t capacity, mfloat_t *b0);
+size_t aabb_tree_intersect_ray(struct aabb_tree *tree, uint32_t *result, size_t capacity, mfloat_t *r0, mfloat_t t_max);
+size_t aabb_tree_pairs(struct aabb_tree *tree, uint32_t *result, size_t capacity);
+#if defined(MATHC_USE_INT)
+mint_t *spatial_hash_cell(mint_t *result, mfloat_t *v0, mfloat_t cell_size);
+size_t spatial_hash_bucket(struct spatial_hash *hash, mint_t *v0);
+void spatial_hash_build(struct spatial_hash *hash, mfloat_t *x, mfloat_t *y, mfloat_t *z, mfloat_t *radius, size_t count);
+size_t spatial_hash_query_radius(struct spatial_hash *hash, uint32_t *result, size_t capacity, mfloat_t *v0, mfloat_t radius);
+size_t spatial_hash_query_nearest(struct spatial_hash *hash, uint32_t *result, mfloat_t *distances, size_t k, mfloat_t *v0, mfloat_t max_distance);
+#endif
+#if defined(MATHC_USE_INT)
+uint64_t linear_octree_key(struct linear_octree *tree, mint_t *v0);
+size_t linear_octree_build(struct linear_octree *tree, mfloat_t *v0, size_t count, uint64_t *keys_scratch, uint32_t *indices, uint32_t *indices_scratch);
+size_t linear_octree_range(struct linear_octree *tree, size_t *first, mint_t *v0, int level);
+size_t linear_octree_neighbors(struct linear_octree *tree, mint_t *result, mint_t *v0, int level);
+size_t linear_octree_query_range(struct linear_octree *tree, size_t *result, size_t capacity, mint_t *v0, mint_t *v1);
+size_t linear_octree_select_lod(struct linear_octree *tree, uint64_t *result, uint8_t *levels, size_t capacity, mfloat_t *v0, mfloat_t error);
+#endif
+mfloat_t *frustum_from_mat4(mfloat_t *result, mfloat_t *m0);
+int frustum_classify_sphere(mfloat_t *f0, mfloat_t *v0, mfloat_t radius);
+int frustum_classify_aabb(mfloat_t *f0, mfloat_t *b0);
+size_t frustum_cull_spheres_n(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *s0, size_t count);
+size_t frustum_cull_aabbs_n(uint32_t *result, uint8_t *classification, mfloat_t *f0, mfloat_t *b0, size_t count);
+struct transform_builder *transform_builder_begin(struct transform_builder *builder);
+struct transform_builder *transform_builder_translate(struct transform_builder *builder, mfloat_t *v0);
+struct transform_builder *transform_builder_rotate(struct transform_builder *builder, mfloat_t *q0);
+struct transform_builder *transform_builder_rotate_axis(struct transform_builder *builder, mfloat_t *v0, mfloat_t angle);
+struct transform_builder *transform_builder_scale(struct transform_builder *builder, mfloat_t *v0);
+struct transform_builder *transform_builder_shear(struct transform_builder *builder, mfloat_t xy, mfloat_t xz, mfloat_t yx, mfloat_t yz, mfloat_t zx, mfloat_t zy);
+struct transform_builder *transform_builder_multiply(struct transform_builder *builder, mfloat_t *m0);
+mfloat_t *transform_builder_finish_mat4(mfloat_t *result, struct transform_builder *builder);
+mfloat_t *transform_builder_finish_mat3x4(mfloat_t *result, struct transform_builder *builder);
+struct slerp_stepper *slerp_stepper_begin(struct slerp_stepper *stepper, mfloat_t *q0, mfloat_t *q1, size_t steps);
+mfloat_t *slerp_stepper_next(mfloat_t *result, struct slerp_stepper *stepper);
+mfloat_t *quat_slerp_steps_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, size_t count);
 #endif
 
 #if defined(MATHC_USE_STRUCT_FUNCTIONS)
@@ -771,6 +1307,14 @@ struct vec4i svec4i_abs(struct vec4i v0);
 struct vec4i svec4i_max(struct vec4i v0, struct vec4i v1);
 struct vec4i svec4i_min(struct vec4i v0, struct vec4i v1);
 struct vec4i svec4i_clamp(struct vec4i v0, struct vec4i v1, struct vec4i v2);
+uint32_t svec2i_to_morton(struct vec2i v0);
+uint64_t svec2i_to_morton64(struct vec2i v0);
+uint32_t svec3i_to_morton(struct vec3i v0);
+uint64_t svec3i_to_morton64(struct vec3i v0);
+struct vec2i svec2i_from_morton(uint32_t code);
+struct vec2i svec2i_from_morton64(uint64_t code);
+struct vec3i svec3i_from_morton(uint32_t code);
+struct vec3i svec3i_from_morton64(uint64_t code);
 #endif
 #if defined(MATHC_USE_FLOATING_POINT)
 bool svec2_is_zero(struct vec2 v0);
@@ -834,6 +1378,8 @@ struct vec3 svec3_subtract_f(struct vec3 v0, mfloat_t f);
 struct vec3 svec3_multiply(struct vec3 v0, struct vec3 v1);
 struct vec3 svec3_multiply_f(struct vec3 v0, mfloat_t f);
 struct vec3 svec3_multiply_mat3(struct vec3 v0, struct mat3 m0);
+struct vec3 svec3_multiply_mat3x4(struct vec3 v0, struct mat3x4 m0);
+struct vec3 svec3_multiply_mat3x4_direction(struct vec3 v0, struct mat3x4 m0);
 struct vec3 svec3_divide(struct vec3 v0, struct vec3 v1);
 struct vec3 svec3_divide_f(struct vec3 v0, mfloat_t f);
 struct vec3 svec3_snap(struct vec3 v0, struct vec3 v1);
@@ -853,6 +1399,7 @@ struct vec3 svec3_project(struct vec3 v0, struct vec3 v1);
 struct vec3 svec3_slide(struct vec3 v0, struct vec3 normal);
 struct vec3 svec3_reflect(struct vec3 v0, struct vec3 normal);
 struct vec3 svec3_rotate(struct vec3 v0, struct vec3 ra, mfloat_t f);
+struct vec3 svec3_rotate_quat(struct vec3 v0, struct quat q0);
 struct vec3 svec3_lerp(struct vec3 v0, struct vec3 v1, mfloat_t f);
 struct vec3 svec3_bezier3(struct vec3 v0, struct vec3 v1, struct vec3 v2, mfloat_t f);
 struct vec3 svec3_bezier4(struct vec3 v0, struct vec3 v1, struct vec3 v2, struct vec3 v3, mfloat_t f);
@@ -912,9 +1459,21 @@ struct quat squat_from_vec3(struct vec3 v0, struct vec3 v1);
 struct quat squat_from_mat4(struct mat4 m0);
 struct quat squat_lerp(struct quat q0, struct quat q1, mfloat_t f);
 struct quat squat_slerp(struct quat q0, struct quat q1, mfloat_t f);
+struct quat squat_slerp_fast(struct quat q0, struct quat q1, mfloat_t f);
 mfloat_t squat_length(struct quat q0);
 mfloat_t squat_length_squared(struct quat q0);
 mfloat_t squat_angle(struct quat q0, struct quat q1);
+struct dualquat sdualquat(struct quat q0, struct quat q1);
+struct dualquat sdualquat_assign(struct dualquat d0);
+struct dualquat sdualquat_null(void);
+struct dualquat sdualquat_from_rotation_translation(struct quat q0, struct vec3 v0);
+struct dualquat sdualquat_from_mat4(struct mat4 m0);
+struct dualquat sdualquat_multiply(struct dualquat d0, struct dualquat d1);
+struct dualquat sdualquat_conjugate(struct dualquat d0);
+struct dualquat sdualquat_normalize(struct dualquat d0);
+struct vec3 sdualquat_translation(struct dualquat d0);
+struct dualquat sdualquat_sclerp(struct dualquat d0, struct dualquat d1, mfloat_t f);
+struct mat4 smat4_from_dualquat(struct dualquat d0);
 struct mat2 smat2(mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22);
 struct mat2 smat2_zero(void);
 struct mat2 smat2_identity(void);
@@ -942,6 +1501,7 @@ struct mat3 smat3_cofactor(struct mat3 m0);
 struct mat3 smat3_multiply(struct mat3 m0, struct mat3 m1);
 struct mat3 smat3_multiply_f(struct mat3 m0, mfloat_t f);
 struct mat3 smat3_inverse(struct mat3 m0);
+struct mat3 smat3_inverse_rigid(struct mat3 m0);
 struct mat3 smat3_scaling(struct vec3 v0);
 struct mat3 smat3_scale(struct mat3 m0, struct vec3 v0);
 struct mat3 smat3_rotation_x(mfloat_t f);
@@ -970,12 +1530,50 @@ struct mat4 smat4_scale(struct mat4 m0, struct vec3 v0);
 struct mat4 smat4_multiply(struct mat4 m0, struct mat4 m1);
 struct mat4 smat4_multiply_f(struct mat4 m0, mfloat_t f);
 struct mat4 smat4_inverse(struct mat4 m0);
+struct mat4 smat4_inverse_affine(struct mat4 m0);
+struct mat4 smat4_inverse_rigid(struct mat4 m0);
 struct mat4 smat4_lerp(struct mat4 m0, struct mat4 m1, mfloat_t f);
 struct mat4 smat4_look_at(struct vec3 position, struct vec3 target, struct vec3 up);
 struct mat4 smat4_ortho(mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f);
 struct mat4 smat4_perspective(mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f);
 struct mat4 smat4_perspective_fov(mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f);
 struct mat4 smat4_perspective_infinite(mfloat_t fov_y, mfloat_t aspect, mfloat_t n);
+struct mat4 smat4_assign_mat3x4(struct mat3x4 m0);
+struct mat3x4 smat3x4(mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34);
+struct mat3x4 smat3x4_zero(void);
+struct mat3x4 smat3x4_identity(void);
+struct mat3x4 smat3x4_assign(struct mat3x4 m0);
+struct mat3x4 smat3x4_assign_mat4(struct mat4 m0);
+struct mat3x4 smat3x4_multiply(struct mat3x4 m0, struct mat3x4 m1);
+struct mat3x4 smat3x4_inverse(struct mat3x4 m0);
+struct trs strs(struct vec3 v0, struct quat q0, struct vec3 v1);
+struct trs strs_identity(void);
+struct trs strs_assign(struct trs t0);
+struct trs strs_multiply(struct trs t0, struct trs t1);
+struct trs strs_inverse(struct trs t0);
+struct trs strs_lerp(struct trs t0, struct trs t1, mfloat_t f);
+struct mat4 strs_to_mat4(struct trs t0);
+struct mat3x4 strs_to_mat3x4(struct trs t0);
+struct aabb saabb(struct vec3 v0, struct vec3 v1);
+struct aabb saabb_assign(struct aabb b0);
+struct vec3 saabb_center(struct aabb b0);
+struct vec3 saabb_extents(struct aabb b0);
+struct aabb saabb_union(struct aabb b0, struct aabb b1);
+struct aabb saabb_intersection(struct aabb b0, struct aabb b1);
+bool saabb_is_empty(struct aabb b0);
+bool saabb_intersects(struct aabb b0, struct aabb b1);
+bool saabb_contains(struct aabb b0, struct aabb b1);
+bool saabb_contains_point(struct aabb b0, struct vec3 v0);
+struct aabb saabb_transform(struct aabb b0, struct mat4 m0);
+struct ray sray(struct vec3 v0, struct vec3 v1);
+struct ray sray_assign(struct ray r0);
+struct vec3 sray_at(struct ray r0, mfloat_t t);
+bool sray_intersect_triangle(struct vec3 *result, struct ray r0, struct vec3 v0, struct vec3 v1, struct vec3 v2);
+struct ray sray_inverse_direction(struct ray r0);
+bool sray_intersect_aabb(mfloat_t *result, struct ray r0, struct aabb b0, mfloat_t t_max);
+struct frustum sfrustum_from_mat4(struct mat4 m0);
+int sfrustum_classify_sphere(struct frustum f0, struct vec3 v0, mfloat_t radius);
+int sfrustum_classify_aabb(struct frustum f0, struct aabb b0);
 #endif
 #endif
 
@@ -1058,6 +1656,22 @@ struct vec4i *psvec4i_abs(struct vec4i *result, struct vec4i *v0);
 struct vec4i *psvec4i_max(struct vec4i *result, struct vec4i *v0, struct vec4i *v1);
 struct vec4i *psvec4i_min(struct vec4i *result, struct vec4i *v0, struct vec4i *v1);
 struct vec4i *psvec4i_clamp(struct vec4i *result, struct vec4i *v0, struct vec4i *v1, struct vec4i *v2);
+uint32_t psvec2i_to_morton(struct vec2i *v0);
+uint64_t psvec2i_to_morton64(struct vec2i *v0);
+uint32_t psvec3i_to_morton(struct vec3i *v0);
+uint64_t psvec3i_to_morton64(struct vec3i *v0);
+struct vec2i *psvec2i_from_morton(struct vec2i *result, uint32_t code);
+struct vec2i *psvec2i_from_morton64(struct vec2i *result, uint64_t code);
+struct vec3i *psvec3i_from_morton(struct vec3i *result, uint32_t code);
+struct vec3i *psvec3i_from_morton64(struct vec3i *result, uint64_t code);
+uint32_t *psvec2i_to_morton_n(uint32_t *result, struct vec2i *v0, size_t count);
+uint64_t *psvec2i_to_morton64_n(uint64_t *result, struct vec2i *v0, size_t count);
+uint32_t *psvec3i_to_morton_n(uint32_t *result, struct vec3i *v0, size_t count);
+uint64_t *psvec3i_to_morton64_n(uint64_t *result, struct vec3i *v0, size_t count);
+struct vec2i *psvec2i_from_morton_n(struct vec2i *result, uint32_t *c0, size_t count);
+struct vec2i *psvec2i_from_morton64_n(struct vec2i *result, uint64_t *c0, size_t count);
+struct vec3i *psvec3i_from_morton_n(struct vec3i *result, uint32_t *c0, size_t count);
+struct vec3i *psvec3i_from_morton64_n(struct vec3i *result, uint64_t *c0, size_t count);
 #endif
 #if defined(MATHC_USE_FLOATING_POINT)
 bool psvec2_is_zero(struct vec2 *v0);
@@ -1121,6 +1735,11 @@ struct vec3 *psvec3_subtract_f(struct vec3 *result, struct vec3 *v0, mfloat_t f)
 struct vec3 *psvec3_multiply(struct vec3 *result, struct vec3 *v0, struct vec3 *v1);
 struct vec3 *psvec3_multiply_f(struct vec3 *result, struct vec3 *v0, mfloat_t f);
 struct vec3 *psvec3_multiply_mat3(struct vec3 *result, struct vec3 *v0, struct mat3 *m0);
+struct vec3 *psvec3_multiply_mat3_n(struct vec3 *result, struct vec3 *v0, struct mat3 *m0, size_t count);
+struct vec3 *psvec3_multiply_mat3x4(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0);
+struct vec3 *psvec3_multiply_mat3x4_n(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0, size_t count);
+struct vec3 *psvec3_multiply_mat3x4_direction(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0);
+struct vec3 *psvec3_multiply_mat3x4_direction_n(struct vec3 *result, struct vec3 *v0, struct mat3x4 *m0, size_t count);
 struct vec3 *psvec3_divide(struct vec3 *result, struct vec3 *v0, struct vec3 *v1);
 struct vec3 *psvec3_divide_f(struct vec3 *result, struct vec3 *v0, mfloat_t f);
 struct vec3 *psvec3_snap(struct vec3 *result, struct vec3 *v0, struct vec3 *v1);
@@ -1140,6 +1759,10 @@ struct vec3 *psvec3_project(struct vec3 *result, struct vec3 *v0, struct vec3 *v
 struct vec3 *psvec3_slide(struct vec3 *result, struct vec3 *v0, struct vec3 *normal);
 struct vec3 *psvec3_reflect(struct vec3 *result, struct vec3 *v0, struct vec3 *normal);
 struct vec3 *psvec3_rotate(struct vec3 *result, struct vec3 *v0, struct vec3 *ra, mfloat_t f);
+struct vec3 *psvec3_rotate_n(struct vec3 *result, struct vec3 *v0, struct vec3 *ra, mfloat_t f, size_t count);
+struct vec3 *psvec3_rotate_quat(struct vec3 *result, struct vec3 *v0, struct quat *q0);
+mfloat_t *psvec3_rotate_quat_n(mfloat_t *result, mfloat_t *v0, size_t stride, struct quat *q0, size_t count);
+mfloat_t *psvec3_rotate_quats_n(mfloat_t *result, mfloat_t *v0, size_t stride, struct quat *q0, size_t count);
 struct vec3 *psvec3_lerp(struct vec3 *result, struct vec3 *v0, struct vec3 *v1, mfloat_t f);
 struct vec3 *psvec3_bezier3(struct vec3 *result, struct vec3 *v0, struct vec3 *v1, struct vec3 *v2, mfloat_t f);
 struct vec3 *psvec3_bezier4(struct vec3 *result, struct vec3 *v0, struct vec3 *v1, struct vec3 *v2, struct vec3 *v3, mfloat_t f);
@@ -1164,6 +1787,7 @@ struct vec4 *psvec4_subtract_f(struct vec4 *result, struct vec4 *v0, mfloat_t f)
 struct vec4 *psvec4_multiply(struct vec4 *result, struct vec4 *v0, struct vec4 *v1);
 struct vec4 *psvec4_multiply_f(struct vec4 *result, struct vec4 *v0, mfloat_t f);
 struct vec4 *psvec4_multiply_mat4(struct vec4 *result, struct vec4 *v0, struct mat4 *m0);
+struct vec4 *psvec4_multiply_mat4_n(struct vec4 *result, struct vec4 *v0, struct mat4 *m0, size_t count);
 struct vec4 *psvec4_divide(struct vec4 *result, struct vec4 *v0, struct vec4 *v1);
 struct vec4 *psvec4_divide_f(struct vec4 *result, struct vec4 *v0, mfloat_t f);
 struct vec4 *psvec4_snap(struct vec4 *result, struct vec4 *v0, struct vec4 *v1);
@@ -1199,9 +1823,22 @@ struct quat *psquat_from_vec3(struct quat *result, struct vec3 *v0, struct vec3
 struct quat *psquat_from_mat4(struct quat *result, struct mat4 *m0);
 struct quat *psquat_lerp(struct quat *result, struct quat *q0, struct quat *q1, mfloat_t f);
 struct quat *psquat_slerp(struct quat *result, struct quat *q0, struct quat *q1, mfloat_t f);
+struct quat *psquat_slerp_fast(struct quat *result, struct quat *q0, struct quat *q1, mfloat_t f);
+struct quat *psquat_slerp_fast_n(struct quat *result, struct quat *q0, struct quat *q1, mfloat_t *f, size_t count);
 mfloat_t psquat_length(struct quat *q0);
 mfloat_t psquat_length_squared(struct quat *q0);
 mfloat_t psquat_angle(struct quat *q0, struct quat *q1);
+struct dualquat *psdualquat(struct dualquat *result, struct quat *q0, struct quat *q1);
+struct dualquat *psdualquat_assign(struct dualquat *result, struct dualquat *d0);
+struct dualquat *psdualquat_null(struct dualquat *result);
+struct dualquat *psdualquat_from_rotation_translation(struct dualquat *result, struct quat *q0, struct vec3 *v0);
+struct dualquat *psdualquat_from_mat4(struct dualquat *result, struct mat4 *m0);
+struct dualquat *psdualquat_multiply(struct dualquat *result, struct dualquat *d0, struct dualquat *d1);
+struct dualquat *psdualquat_conjugate(struct dualquat *result, struct dualquat *d0);
+struct dualquat *psdualquat_normalize(struct dualquat *result, struct dualquat *d0);
+struct vec3 *psdualquat_translation(struct vec3 *result, struct dualquat *d0);
+struct dualquat *psdualquat_sclerp(struct dualquat *result, struct dualquat *d0, struct dualquat *d1, mfloat_t f);
+struct mat4 *psmat4_from_dualquat(struct mat4 *result, struct dualquat *d0);
 struct mat2 *psmat2(struct mat2 *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22);
 struct mat2 *psmat2_zero(struct mat2 *result);
 struct mat2 *psmat2_identity(struct mat2 *result);
@@ -1229,6 +1866,8 @@ struct mat3 *psmat3_cofactor(struct mat3 *result, struct mat3 *m0);
 struct mat3 *psmat3_multiply(struct mat3 *result, struct mat3 *m0, struct mat3 *m1);
 struct mat3 *psmat3_multiply_f(struct mat3 *result, struct mat3 *m0, mfloat_t f);
 struct mat3 *psmat3_inverse(struct mat3 *result, struct mat3 *m0);
+struct mat3 *psmat3_inverse_rigid(struct mat3 *result, struct mat3 *m0);
+struct mat3 *psmat3_inverse_rigid_n(struct mat3 *result, struct mat3 *m0, size_t count);
 struct mat3 *psmat3_scaling(struct mat3 *result, struct vec3 *v0);
 struct mat3 *psmat3_scale(struct mat3 *result, struct mat3 *m0, struct vec3 *v0);
 struct mat3 *psmat3_rotation_x(struct mat3 *result, mfloat_t f);
@@ -1257,12 +1896,68 @@ struct mat4 *psmat4_scale(struct mat4 *result, struct mat4 *m0, struct vec3 *v0)
 struct mat4 *psmat4_multiply(struct mat4 *result, struct mat4 *m0, struct mat4 *m1);
 struct mat4 *psmat4_multiply_f(struct mat4 *result, struct mat4 *m0, mfloat_t f);
 struct mat4 *psmat4_inverse(struct mat4 *result, struct mat4 *m0);
+struct mat4 *psmat4_inverse_n(struct mat4 *result, struct mat4 *m0, size_t count);
+struct mat4 *psmat4_inverse_affine(struct mat4 *result, struct mat4 *m0);
+struct mat4 *psmat4_inverse_affine_n(struct mat4 *result, struct mat4 *m0, size_t count);
+struct mat4 *psmat4_inverse_rigid(struct mat4 *result, struct mat4 *m0);
+struct mat4 *psmat4_inverse_rigid_n(struct mat4 *result, struct mat4 *m0, size_t count);
 struct mat4 *psmat4_lerp(struct mat4 *result, struct mat4 *m0, struct mat4 *m1, mfloat_t f);
 struct mat4 *psmat4_look_at(struct mat4 *result, struct vec3 *position, struct vec3 *target, struct vec3 *up);
 struct mat4 *psmat4_ortho(struct mat4 *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f);
 struct mat4 *psmat4_perspective(struct mat4 *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f);
 struct mat4 *psmat4_perspective_fov(struct mat4 *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f);
 struct mat4 *psmat4_perspective_infinite(struct mat4 *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n);
+struct mat4 *psmat4_assign_mat3x4(struct mat4 *result, struct mat3x4 *m0);
+struct mat3x4 *psmat3x4(struct mat3x4 *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34);
+struct mat3x4 *psmat3x4_zero(struct mat3x4 *result);
+struct mat3x4 *psmat3x4_identity(struct mat3x4 *result);
+struct mat3x4 *psmat3x4_assign(struct mat3x4 *result, struct mat3x4 *m0);
+struct mat3x4 *psmat3x4_assign_mat4(struct mat3x4 *result, struct mat4 *m0);
+struct mat3x4 *psmat3x4_multiply(struct mat3x4 *result, struct mat3x4 *m0, struct mat3x4 *m1);
+struct mat3x4 *psmat3x4_multiply_n(struct mat3x4 *result, struct mat3x4 *m0, struct mat3x4 *m1, size_t count);
+struct mat3x4 *psmat3x4_inverse(struct mat3x4 *result, struct mat3x4 *m0);
+struct mat3x4 *psmat3x4_inverse_n(struct mat3x4 *result, struct mat3x4 *m0, size_t count);
+struct trs *pstrs(struct trs *result, struct vec3 *v0, struct quat *q0, struct vec3 *v1);
+struct trs *pstrs_identity(struct trs *result);
+struct trs *pstrs_assign(struct trs *result, struct trs *t0);
+struct trs *pstrs_multiply(struct trs *result, struct trs *t0, struct trs *t1);
+struct trs *pstrs_inverse(struct trs *result, struct trs *t0);
+struct trs *pstrs_lerp(struct trs *result, struct trs *t0, struct trs *t1, mfloat_t f);
+struct trs *pstrs_lerp_n(struct trs *result, struct trs *t0, struct trs *t1, mfloat_t f, size_t count);
+struct mat4 *pstrs_to_mat4(struct mat4 *result, struct trs *t0);
+struct mat4 *pstrs_to_mat4_n(struct mat4 *result, struct trs *t0, size_t count);
+struct mat3x4 *pstrs_to_mat3x4(struct mat3x4 *result, struct trs *t0);
+struct mat3x4 *pstrs_to_mat3x4_n(struct mat3x4 *result, struct trs *t0, size_t count);
+void psdualquat_skin_n(struct vec3 *result_positions, struct vec3 *result_normals, struct vec3 *positions, struct vec3 *normals, uint16_t *indices, struct vec4 *weights, struct dualquat *palette, size_t count);
+void psmat4_skin_n(struct vec3 *result_positions, struct vec3 *result_normals, struct vec3 *positions, struct vec3 *normals, uint16_t *indices, struct vec4 *weights, struct mat4 *palette, size_t count);
+void psmat3x4_skin_n(struct vec3 *result_positions, struct vec3 *result_normals, struct vec3 *positions, struct vec3 *normals, uint16_t *indices, struct vec4 *weights, struct mat3x4 *palette, size_t count);
+struct aabb *psaabb(struct aabb *result, struct vec3 *v0, struct vec3 *v1);
+struct aabb *psaabb_assign(struct aabb *result, struct aabb *b0);
+struct aabb *psaabb_from_points_n(struct aabb *result, struct vec3 *v0, size_t count);
+struct vec3 *psaabb_center(struct vec3 *result, struct aabb *b0);
+struct vec3 *psaabb_extents(struct vec3 *result, struct aabb *b0);
+struct aabb *psaabb_union(struct aabb *result, struct aabb *b0, struct aabb *b1);
+struct aabb *psaabb_intersection(struct aabb *result, struct aabb *b0, struct aabb *b1);
+bool psaabb_is_empty(struct aabb *b0);
+bool psaabb_intersects(struct aabb *b0, struct aabb *b1);
+bool psaabb_contains(struct aabb *b0, struct aabb *b1);
+bool psaabb_contains_point(struct aabb *b0, struct vec3 *v0);
+struct aabb *psaabb_transform(struct aabb *result, struct aabb *b0, struct mat4 *m0);
+struct aabb *psaabb_transform_n(struct aabb *result, struct aabb *b0, struct mat4 *m0, size_t count);
+struct ray *psray(struct ray *result, struct vec3 *v0, struct vec3 *v1);
+struct ray *psray_assign(struct ray *result, struct ray *r0);
+struct vec3 *psray_at(struct vec3 *result, struct ray *r0, mfloat_t t);
+bool psray_intersect_triangle(struct vec3 *result, struct ray *r0, struct vec3 *v0, struct vec3 *v1, struct vec3 *v2);
+size_t psray_intersect_triangles_n(struct vec3 *result, struct ray *r0, struct vec3 *t0, size_t count);
+size_t psrays_intersect_triangle_n(struct vec3 *result, struct ray *r0, struct vec3 *v0, struct vec3 *v1, struct vec3 *v2, size_t count);
+struct ray *psray_inverse_direction(struct ray *result, struct ray *r0);
+bool psray_intersect_aabb(mfloat_t *result, struct ray *r0, struct aabb *b0, mfloat_t t_max);
+size_t psray_intersect_aabbs_n(mfloat_t *result, uint32_t *mask, struct ray *r0, mfloat_t *b0, size_t stride, mfloat_t t_max, size_t count);
+struct frustum *psfrustum_from_mat4(struct frustum *result, struct mat4 *m0);
+int psfrustum_classify_sphere(struct frustum *f0, struct vec3 *v0, mfloat_t radius);
+int psfrustum_classify_aabb(struct frustum *f0, struct aabb *b0);
+size_t psfrustum_cull_spheres_n(uint32_t *result, uint8_t *classification, struct frustum *f0, struct vec4 *s0, size_t count);
+size_t psfrustum_cull_aabbs_n(uint32_t *result, uint8_t *classification, struct frustum *f0, struct aabb *b0, size_t count);
 #endif
 #endif
 